@@ -0,0 +1,55 @@
+// Helpers shared by the benchmarks. Include after clay.h.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Milliseconds from a monotonic clock
+static double Benchmark_Now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1000.0 + (double)time.tv_nsec / 1000000.0;
+}
+
+// A deterministic random number generator, so that every run declares the same layout
+static uint32_t benchmarkRandomState = 1;
+
+static void Benchmark_Seed(uint32_t seed) {
+    benchmarkRandomState = seed;
+}
+
+static uint32_t Benchmark_Random(void) {
+    benchmarkRandomState = benchmarkRandomState * 1103515245u + 12345u;
+    return (benchmarkRandomState >> 8) & 0xffff;
+}
+
+// A stand-in for a font, where every character has the same width
+static Clay_Dimensions Benchmark_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData) {
+    return CLAY__INIT(Clay_Dimensions) { (float)text.length * (float)config->fontSize * 0.6f, (float)config->fontSize };
+}
+
+static void Benchmark_HandleError(Clay_ErrorData errorData) {
+    fprintf(stderr, "%.*s\n", errorData.errorText.length, errorData.errorText.chars);
+}
+
+static void Benchmark_Initialize(int32_t maxElementCount) {
+    Clay_SetMaxElementCount(maxElementCount);
+    uint64_t size = Clay_MinMemorySize();
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(size, malloc(size)), CLAY__INIT(Clay_Dimensions) { 1920, 1080 }, CLAY__INIT(Clay_ErrorHandler) { Benchmark_HandleError });
+    Clay_SetMeasureTextFunction(Benchmark_MeasureText, NULL);
+}
+
+// Hashes the bounding boxes of the render commands, to check that a faster path produces the same layout
+static uint64_t Benchmark_HashRenderCommands(Clay_RenderCommandArray renderCommands) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int32_t i = 0; i < renderCommands.length; i++) {
+        Clay_BoundingBox box = renderCommands.internalArray[i].boundingBox;
+        const unsigned char *bytes = (const unsigned char *)&box;
+        for (size_t j = 0; j < sizeof(box); j++) {
+            hash = (hash ^ bytes[j]) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,78 @@
+// Measures how long it takes to look up an element by id, for elements that exist and for ids that don't,
+// at a range of element counts. Lookups happen in pointer handling, scrolling, floating attachment and transitions.
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+
+#define LOOKUP_COUNT 20000000
+
+static int32_t elementCounts[] = { 3000, 30000, 250000 };
+
+static void DeclareLayout(int32_t elementCount) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("ElementLookup"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } } }) {
+        for (int32_t i = 0; i < elementCount; i++) {
+            CLAY(CLAY_IDI("LookupElement", i), { .layout = { .sizing = { CLAY_SIZING_FIXED(1), CLAY_SIZING_FIXED(1) } } }) {}
+        }
+    }
+}
+
+// Returns the average time of a lookup in nanoseconds
+static double TimeLookups(Clay_ElementId *ids, int32_t idCount, int32_t *foundCount) {
+    int32_t repeatCount = LOOKUP_COUNT / idCount;
+    *foundCount = 0;
+    double start = Benchmark_Now();
+    for (int32_t repeat = 0; repeat < repeatCount; repeat++) {
+        for (int32_t i = 0; i < idCount; i++) {
+            *foundCount += Clay_GetElementData(ids[i]).found;
+        }
+    }
+    return (Benchmark_Now() - start) * 1000000.0 / ((double)repeatCount * idCount);
+}
+
+int main(void) {
+    int result = 0;
+    for (int32_t countIndex = 0; countIndex < (int32_t)(sizeof(elementCounts) / sizeof(elementCounts[0])); countIndex++) {
+        int32_t elementCount = elementCounts[countIndex];
+        // The table is as full as it can get when every element that Clay has room for is declared
+        Clay_SetMaxElementCount(elementCount + 16);
+        uint64_t memorySize = Clay_MinMemorySize();
+        void *memory = malloc(memorySize);
+        Clay_Context *context = Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(memorySize, memory), CLAY__INIT(Clay_Dimensions) { 1920, 1080 }, CLAY__INIT(Clay_ErrorHandler) { Benchmark_HandleError });
+        Clay_SetMeasureTextFunction(Benchmark_MeasureText, NULL);
+        DeclareLayout(elementCount);
+        Clay_EndLayout(0);
+
+        Clay_ElementId *hitIds = malloc(sizeof(Clay_ElementId) * elementCount);
+        Clay_ElementId *missIds = malloc(sizeof(Clay_ElementId) * elementCount);
+        for (int32_t i = 0; i < elementCount; i++) {
+            hitIds[i] = CLAY_IDI("LookupElement", i);
+            missIds[i] = CLAY_IDI("MissingElement", i);
+        }
+        // Looking elements up in declaration order would walk the table in order, so shuffle them
+        Benchmark_Seed(1);
+        for (int32_t i = elementCount - 1; i > 0; i--) {
+            int32_t j = (int32_t)(((uint32_t)Benchmark_Random() << 16 | Benchmark_Random()) % (uint32_t)(i + 1));
+            Clay_ElementId swap = hitIds[i];
+            hitIds[i] = hitIds[j];
+            hitIds[j] = swap;
+        }
+
+        int32_t hitFoundCount, missFoundCount;
+        double hitTime = TimeLookups(hitIds, elementCount, &hitFoundCount);
+        double missTime = TimeLookups(missIds, elementCount, &missFoundCount);
+        printf("%d elements: hit %.2f ns, miss %.2f ns, table %.1f bytes per element, %.0f%% full\n", elementCount, hitTime, missTime,
+            (double)context->layoutElementsHashMap.capacity * sizeof(Clay__LayoutElementHashMapSlot) / elementCount,
+            100.0 * context->layoutElementsHashMapInternal.length / context->layoutElementsHashMap.capacity);
+        if (hitFoundCount == 0 || missFoundCount != 0) {
+            printf("%d elements: lookups found the wrong elements\n", elementCount);
+            result = 1;
+        }
+        free(hitIds);
+        free(missIds);
+        // The context lives in the arena, so it can't stay current once the arena is freed
+        Clay_SetCurrentContext(NULL);
+        free(memory);
+    }
+    return result;
+}
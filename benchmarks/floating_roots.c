@@ -0,0 +1,88 @@
+// Measures Clay_EndLayout() with thousands of floating elements at mixed z indices, such as markers and tooltips on a map,
+// and checks that their render commands come out sorted by z index, with equal z indices kept in declaration order.
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+
+#define MAX_FLOATING_COUNT 10000
+#define Z_INDEX_LEVEL_COUNT 11
+#define FRAME_COUNT 20
+
+static int16_t zIndices[MAX_FLOATING_COUNT];
+// The ids of the floating elements, in declaration order
+static uint32_t floatingIds[MAX_FLOATING_COUNT];
+
+static void DeclareLayout(int32_t floatingCount) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("FloatingRoots"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } } }) {
+        for (int32_t i = 0; i < floatingCount; i++) {
+            CLAY(CLAY_IDI("Marker", i), {
+                .layout = { .sizing = { CLAY_SIZING_FIXED(8), CLAY_SIZING_FIXED(8) } },
+                .backgroundColor = { 255, 0, 0, 255 },
+                .floating = { .attachTo = CLAY_ATTACH_TO_PARENT, .offset = { (float)(i % 1900), (float)(i / 1900 * 10) }, .zIndex = zIndices[i] }
+            }) {}
+        }
+    }
+}
+
+static int32_t DeclarationIndex(uint32_t id, int32_t floatingCount) {
+    for (int32_t i = 0; i < floatingCount; i++) {
+        if (floatingIds[i] == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns false if the floating elements' render commands are out of z order, or if ties are out of declaration order
+static bool CheckOrder(Clay_RenderCommandArray renderCommands, int32_t floatingCount) {
+    int16_t previousZIndex = INT16_MIN;
+    int32_t previousIndex = -1;
+    int32_t checkedCount = 0;
+    for (int32_t i = 0; i < renderCommands.length; i++) {
+        Clay_RenderCommand *command = &renderCommands.internalArray[i];
+        int32_t index = DeclarationIndex(command->id, floatingCount);
+        if (index < 0) {
+            continue;
+        }
+        if (command->zIndex < previousZIndex || (command->zIndex == previousZIndex && index < previousIndex)) {
+            return false;
+        }
+        previousZIndex = command->zIndex;
+        previousIndex = index;
+        checkedCount++;
+    }
+    return checkedCount == floatingCount;
+}
+
+int main(void) {
+    // Every floating element stores a floating config
+    Clay_SetMaxElementConfigCount(MAX_FLOATING_COUNT + 16);
+    Benchmark_Initialize(MAX_FLOATING_COUNT * 2);
+    Clay_SetCullingEnabled(false);
+    int result = 0;
+    int32_t floatingCounts[] = { 1000, 10000 };
+    for (int32_t countIndex = 0; countIndex < 2; countIndex++) {
+        int32_t floatingCount = floatingCounts[countIndex];
+        // Every z index is used by many elements, and they are declared in no particular z order
+        Benchmark_Seed(1);
+        for (int32_t i = 0; i < floatingCount; i++) {
+            zIndices[i] = (int16_t)((int32_t)(Benchmark_Random() % Z_INDEX_LEVEL_COUNT) - Z_INDEX_LEVEL_COUNT / 2);
+            floatingIds[i] = CLAY_IDI("Marker", i).id;
+        }
+        // The first frame fills the element hash map, and isn't timed
+        DeclareLayout(floatingCount);
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout(0);
+        bool ordered = CheckOrder(renderCommands, floatingCount);
+        double totalTime = 0;
+        for (int32_t frame = 0; frame < FRAME_COUNT; frame++) {
+            DeclareLayout(floatingCount);
+            double start = Benchmark_Now();
+            Clay_EndLayout(0);
+            totalTime += Benchmark_Now() - start;
+        }
+        printf("%d floating elements: Clay_EndLayout %.3f ms%s\n", floatingCount, totalTime / FRAME_COUNT, ordered ? "" : ", RENDER COMMANDS OUT OF ORDER");
+        result |= ordered ? 0 : 1;
+    }
+    return result;
+}
@@ -0,0 +1,136 @@
+// Measures what Clay_SetIncrementalLayoutEnabled() saves on a large layout where only a small part changes each frame,
+// and checks that it produces the same layout as a full one.
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+#include <stdbool.h>
+
+#define LIST_ITEM_COUNT 2000
+#define CARD_COUNT 200
+#define GRID_ROW_COUNT 100
+#define GRID_COLUMN_COUNT 60
+#define FRAME_COUNT 200
+
+static const char *words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "sed", "do", "eiusmod", "tempor" };
+
+static char listItemText[LIST_ITEM_COUNT][64];
+static Clay_String listItemStrings[LIST_ITEM_COUNT];
+static char cardText[CARD_COUNT][512];
+static Clay_String cardStrings[CARD_COUNT];
+static const Clay_TextElementConfig textConfig = { .fontSize = 16, .textColor = { 0, 0, 0, 255 } };
+
+static Clay_String RandomText(char *buffer, int32_t capacity, int32_t wordCount) {
+    int32_t length = 0;
+    for (int32_t i = 0; i < wordCount; i++) {
+        length += snprintf(buffer + length, capacity - length, i == 0 ? "%s" : " %s", words[Benchmark_Random() % (sizeof(words) / sizeof(words[0]))]);
+    }
+    return CLAY__INIT(Clay_String) { .length = length, .chars = buffer };
+}
+
+static Clay_String HeaderText(int32_t frame) {
+    static char header[32];
+    return CLAY__INIT(Clay_String) { .length = snprintf(header, sizeof(header), "Frame %d", frame), .chars = header };
+}
+
+// A sidebar with a long list, and a list of cards with wrapped text. Only the header's frame counter changes from frame to frame.
+// Most of the time goes to wrapping text, which is cached whether or not incremental layout is enabled.
+static void DeclareTextLayout(int32_t frame) {
+    Clay_String headerString = HeaderText(frame);
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("IncrementalLayout"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
+        CLAY(CLAY_ID("Header"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(40) }, .padding = CLAY_PADDING_ALL(8) }, .backgroundColor = { 200, 200, 200, 255 } }) {
+            CLAY_TEXT(headerString, textConfig);
+        }
+        CLAY(CLAY_ID("Body"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 8 } }) {
+            CLAY(CLAY_ID("Sidebar"), { .layout = { .sizing = { CLAY_SIZING_FIXED(300), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM }, .clip = { .vertical = true } }) {
+                for (int32_t i = 0; i < LIST_ITEM_COUNT; i++) {
+                    CLAY(CLAY_IDI("ListItem", i), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = { 8, 8, 4, 4 } }, .backgroundColor = { 240, 240, 240, 255 } }) {
+                        CLAY_TEXT(listItemStrings[i], textConfig);
+                    }
+                }
+            }
+            CLAY(CLAY_ID("CardList"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 8 }, .clip = { .vertical = true } }) {
+                for (int32_t i = 0; i < CARD_COUNT; i++) {
+                    CLAY(CLAY_IDI("Card", i), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = CLAY_PADDING_ALL(12), .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 4 }, .backgroundColor = { 255, 255, 255, 255 }, .cornerRadius = CLAY_CORNER_RADIUS(6) }) {
+                        CLAY_TEXT(listItemStrings[i], textConfig);
+                        CLAY_TEXT(cardStrings[i], textConfig);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Rows of cells that grow between a minimum and a maximum width, so that distributing space takes several passes per row.
+// Only the header's frame counter changes from frame to frame.
+static void DeclareGridLayout(int32_t frame) {
+    Clay_String headerString = HeaderText(frame);
+    Benchmark_Seed(3);
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("IncrementalGrid"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
+        CLAY(CLAY_ID("GridHeader"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(40) }, .padding = CLAY_PADDING_ALL(8) }, .backgroundColor = { 200, 200, 200, 255 } }) {
+            CLAY_TEXT(headerString, textConfig);
+        }
+        for (int32_t row = 0; row < GRID_ROW_COUNT; row++) {
+            CLAY(CLAY_IDI("GridRow", row), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = CLAY_PADDING_ALL(2), .childGap = 2 } }) {
+                for (int32_t column = 0; column < GRID_COLUMN_COUNT; column++) {
+                    float minWidth = (float)(Benchmark_Random() % 10);
+                    float maxWidth = (float)(20 + Benchmark_Random() % 60);
+                    CLAY(CLAY_IDI("GridCell", row * GRID_COLUMN_COUNT + column), { .layout = { .sizing = { CLAY_SIZING_GROW(minWidth, maxWidth), CLAY_SIZING_GROW(0, 30) } }, .backgroundColor = { 255, 0, 0, 255 } }) {}
+                }
+            }
+        }
+    }
+}
+
+static uint64_t RunFrames(void (*declareLayout)(int32_t frame), bool incremental, double *frameTime, double *endLayoutTime) {
+    Clay_SetIncrementalLayoutEnabled(incremental);
+    // The first frames fill the text measurement cache and the fingerprints from the previous frame, and aren't timed
+    for (int32_t frame = 0; frame < 2; frame++) {
+        declareLayout(frame);
+        Clay_EndLayout(0);
+    }
+    double totalTime = 0;
+    double totalEndLayoutTime = 0;
+    uint64_t hash = 0;
+    for (int32_t frame = 2; frame < FRAME_COUNT + 2; frame++) {
+        double start = Benchmark_Now();
+        declareLayout(frame);
+        double endLayoutStart = Benchmark_Now();
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout(0);
+        double end = Benchmark_Now();
+        totalTime += end - start;
+        totalEndLayoutTime += end - endLayoutStart;
+        hash ^= Benchmark_HashRenderCommands(renderCommands) + (uint64_t)frame;
+    }
+    *frameTime = totalTime / FRAME_COUNT;
+    *endLayoutTime = totalEndLayoutTime / FRAME_COUNT;
+    return hash;
+}
+
+static int RunScenario(const char *name, void (*declareLayout)(int32_t frame)) {
+    double fullFrameTime, fullEndLayoutTime, incrementalFrameTime, incrementalEndLayoutTime;
+    uint64_t fullHash = RunFrames(declareLayout, false, &fullFrameTime, &fullEndLayoutTime);
+    uint64_t incrementalHash = RunFrames(declareLayout, true, &incrementalFrameTime, &incrementalEndLayoutTime);
+    printf("%s, full layout:        %.3f ms/frame, Clay_EndLayout %.3f ms\n", name, fullFrameTime, fullEndLayoutTime);
+    printf("%s, incremental layout: %.3f ms/frame, Clay_EndLayout %.3f ms, %.2fx%s\n", name, incrementalFrameTime, incrementalEndLayoutTime, fullEndLayoutTime / incrementalEndLayoutTime,
+        incrementalHash == fullHash ? "" : ", LAYOUT DIFFERS FROM FULL LAYOUT");
+    return incrementalHash == fullHash ? 0 : 1;
+}
+
+int main(void) {
+    Benchmark_Initialize(16384);
+    // Culling would leave most of the layout out of the render commands that are compared
+    Clay_SetCullingEnabled(false);
+    for (int32_t i = 0; i < LIST_ITEM_COUNT; i++) {
+        listItemStrings[i] = RandomText(listItemText[i], sizeof(listItemText[i]), 1 + (int32_t)(Benchmark_Random() % 4));
+    }
+    for (int32_t i = 0; i < CARD_COUNT; i++) {
+        cardStrings[i] = RandomText(cardText[i], sizeof(cardText[i]), 20 + (int32_t)(Benchmark_Random() % 40));
+    }
+
+    int result = 0;
+    result |= RunScenario("text", DeclareTextLayout);
+    result |= RunScenario("grid", DeclareGridLayout);
+    return result;
+}
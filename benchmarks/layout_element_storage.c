@@ -0,0 +1,136 @@
+// Measures how long Clay_EndLayout() takes on a wide tree and on a deep tree, which is mostly spent in the sizing passes that
+// walk Clay_LayoutElement. On Linux, it also counts the cache misses of Clay_EndLayout() when hardware counters are available.
+// For syscall(), which isn't part of POSIX
+#define _DEFAULT_SOURCE
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+#include <stdbool.h>
+#include <string.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define WIDE_ROW_COUNT 64
+#define WIDE_CHILDREN_PER_ROW 500
+#define DEEP_COLUMN_COUNT 32
+#define DEEP_COLUMN_DEPTH 1000
+#define FRAME_COUNT 60
+
+// Returns -1 if cache misses can't be counted, for example in a virtual machine or when perf events are restricted
+static int OpenCacheMissCounter(void) {
+#ifdef __linux__
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void StartCounting(int counter) {
+#ifdef __linux__
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static uint64_t StopCounting(int counter) {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &count, sizeof(count)) != sizeof(count)) {
+            count = 0;
+        }
+    }
+#endif
+    return count;
+}
+
+static Clay_SizingAxis RandomSizing(void) {
+    switch (Benchmark_Random() % 3) {
+        case 0: return CLAY_SIZING_FIXED((float)(Benchmark_Random() % 20));
+        case 1: return CLAY_SIZING_GROW((float)(Benchmark_Random() % 5), (float)(5 + Benchmark_Random() % 20));
+        default: return CLAY_SIZING_FIT(0);
+    }
+}
+
+// Rows with hundreds of children each, so sizing spends its time looping over the children of a few parents
+static void DeclareWideTree(int32_t frame) {
+    Benchmark_Seed(1);
+    Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 1920.f + (float)(frame % 7), 1080 });
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("WideTree"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
+        for (int32_t row = 0; row < WIDE_ROW_COUNT; row++) {
+            CLAY(CLAY_IDI("WideRow", row), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 1 } }) {
+                for (int32_t child = 0; child < WIDE_CHILDREN_PER_ROW; child++) {
+                    CLAY(CLAY_IDI("WideChild", row * WIDE_CHILDREN_PER_ROW + child), { .layout = { .sizing = { RandomSizing(), RandomSizing() } }, .backgroundColor = { 255, 255, 255, 255 } }) {}
+                }
+            }
+        }
+    }
+}
+
+static void DeclareNestedElements(int32_t column, int32_t depth) {
+    if (depth == DEEP_COLUMN_DEPTH) {
+        return;
+    }
+    CLAY(CLAY_IDI("DeepElement", column * DEEP_COLUMN_DEPTH + depth), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = { 0, 0, 1, 0 } }, .backgroundColor = { 255, 255, 255, 255 } }) {
+        DeclareNestedElements(column, depth + 1);
+    }
+}
+
+// Columns of elements nested a thousand deep, so sizing spends its time moving from parent to child
+static void DeclareDeepTree(int32_t frame) {
+    Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 1920.f + (float)(frame % 7), 1080 });
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("DeepTree"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } } }) {
+        for (int32_t column = 0; column < DEEP_COLUMN_COUNT; column++) {
+            DeclareNestedElements(column, 0);
+        }
+    }
+}
+
+static void RunScenario(const char *name, void (*declareLayout)(int32_t frame), int cacheMissCounter) {
+    // The first frame fills the element hash map, and isn't timed
+    declareLayout(0);
+    Clay_EndLayout(0);
+    double totalTime = 0;
+    uint64_t cacheMisses = 0;
+    for (int32_t frame = 1; frame <= FRAME_COUNT; frame++) {
+        declareLayout(frame);
+        StartCounting(cacheMissCounter);
+        double start = Benchmark_Now();
+        Clay_EndLayout(0);
+        totalTime += Benchmark_Now() - start;
+        cacheMisses += StopCounting(cacheMissCounter);
+    }
+    if (cacheMissCounter >= 0) {
+        printf("%s: Clay_EndLayout %.3f ms, %llu cache misses per frame\n", name, totalTime / FRAME_COUNT, (unsigned long long)(cacheMisses / FRAME_COUNT));
+    } else {
+        printf("%s: Clay_EndLayout %.3f ms, cache misses unavailable\n", name, totalTime / FRAME_COUNT);
+    }
+}
+
+int main(void) {
+    Benchmark_Initialize(1 << 16);
+    // Culling would skip most of the render commands, which aren't what this measures
+    Clay_SetCullingEnabled(false);
+    int cacheMissCounter = OpenCacheMissCounter();
+    printf("Clay_LayoutElement is %d bytes\n", (int)sizeof(Clay_LayoutElement));
+    RunScenario("wide tree", DeclareWideTree, cacheMissCounter);
+    RunScenario("deep tree", DeclareDeepTree, cacheMissCounter);
+    return 0;
+}
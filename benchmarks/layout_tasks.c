@@ -0,0 +1,180 @@
+// Measures how container sizing scales with the number of threads given to Clay_SetLayoutTaskDispatchFunction(),
+// and checks that every thread count produces the same layout as a single thread.
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+#include <pthread.h>
+#include <stdbool.h>
+
+#define MAX_THREAD_COUNT 8
+#define COLUMN_COUNT 64
+#define ROWS_PER_COLUMN 300
+#define FRAME_COUNT 60
+
+// A minimal fork / join pool. Workers take task indices from a shared counter until the batch runs out.
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t start;
+    pthread_cond_t finished;
+    pthread_t threads[MAX_THREAD_COUNT];
+    int32_t threadCount;
+    void (*task)(int32_t taskIndex, void *taskData);
+    void *taskData;
+    int32_t taskCount;
+    int32_t nextTask;
+    int32_t finishedTasks;
+    int32_t generation;
+    bool quit;
+} TaskPool;
+
+// Runs tasks from the current batch until there are none left. Called with the mutex held.
+static void TaskPool_RunTasks(TaskPool *pool) {
+    while (pool->nextTask < pool->taskCount) {
+        int32_t taskIndex = pool->nextTask++;
+        pthread_mutex_unlock(&pool->mutex);
+        pool->task(taskIndex, pool->taskData);
+        pthread_mutex_lock(&pool->mutex);
+        if (++pool->finishedTasks == pool->taskCount) {
+            pthread_cond_signal(&pool->finished);
+        }
+    }
+}
+
+static void *TaskPool_Worker(void *userData) {
+    TaskPool *pool = (TaskPool *)userData;
+    int32_t generation = 0;
+    pthread_mutex_lock(&pool->mutex);
+    while (true) {
+        while (pool->generation == generation && !pool->quit) {
+            pthread_cond_wait(&pool->start, &pool->mutex);
+        }
+        if (pool->quit) {
+            break;
+        }
+        generation = pool->generation;
+        TaskPool_RunTasks(pool);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+static void TaskPool_Start(TaskPool *pool, int32_t threadCount) {
+    *pool = (TaskPool) { .threadCount = threadCount };
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+    // The thread that calls Clay_EndLayout() runs tasks as well
+    for (int32_t i = 1; i < threadCount; i++) {
+        pthread_create(&pool->threads[i], NULL, TaskPool_Worker, pool);
+    }
+}
+
+static void TaskPool_Stop(TaskPool *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    for (int32_t i = 1; i < pool->threadCount; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->finished);
+}
+
+static void DispatchLayoutTasks(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, void *userData) {
+    TaskPool *pool = (TaskPool *)userData;
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->taskData = taskData;
+    pool->taskCount = taskCount;
+    pool->nextTask = 0;
+    pool->finishedTasks = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    TaskPool_RunTasks(pool);
+    while (pool->finishedTasks < pool->taskCount) {
+        pthread_cond_wait(&pool->finished, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static Clay_SizingAxis RandomSizing(void) {
+    switch (Benchmark_Random() % 4) {
+        case 0: return CLAY_SIZING_FIXED((float)(Benchmark_Random() % 40));
+        case 1: return CLAY_SIZING_GROW((float)(Benchmark_Random() % 20), Benchmark_Random() % 2 ? CLAY__MAXFLOAT : 60.f);
+        case 2: return CLAY_SIZING_FIT(0);
+        default: return CLAY_SIZING_GROW(0);
+    }
+}
+
+// Wide columns of rows of cells, so that the levels below the root have enough children to be split into tasks.
+// Indexed IDs are used because the IDs of CLAY_AUTO_ID() elements collide in a layout this large.
+static void DeclareLayout(int32_t frame) {
+    Benchmark_Seed(1);
+    // Resizing every frame means that nothing can be reused from the previous frame
+    Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 1920.f + (float)(frame % 7), 1080 });
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("LayoutTasks"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 2 } }) {
+        for (int32_t column = 0; column < COLUMN_COUNT; column++) {
+            CLAY(CLAY_IDI("Column", column), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 1 } }) {
+                for (int32_t row = 0; row < ROWS_PER_COLUMN; row++) {
+                    int32_t rowIndex = column * ROWS_PER_COLUMN + row;
+                    CLAY(CLAY_IDI("Row", rowIndex), { .layout = { .sizing = { RandomSizing(), RandomSizing() }, .padding = CLAY_PADDING_ALL(1), .childGap = 1 }, .backgroundColor = { 255, 255, 255, 255 } }) {
+                        int32_t cellCount = 1 + (int32_t)(Benchmark_Random() % 4);
+                        for (int32_t cell = 0; cell < cellCount; cell++) {
+                            CLAY(CLAY_IDI("Cell", rowIndex * 4 + cell), { .layout = { .sizing = { RandomSizing(), RandomSizing() } }, .backgroundColor = { 255, 0, 0, 255 } }) {}
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main(void) {
+    Benchmark_Initialize(1 << 18);
+    // Culling would leave most of the layout out of the render commands that are compared
+    Clay_SetCullingEnabled(false);
+
+    uint64_t singleThreadHash = 0;
+    double singleThreadTime = 0;
+    for (int32_t threadCount = 1; threadCount <= MAX_THREAD_COUNT; threadCount *= 2) {
+        TaskPool pool;
+        TaskPool_Start(&pool, threadCount);
+        Clay_SetLayoutTaskDispatchFunction(threadCount > 1 ? DispatchLayoutTasks : NULL, &pool);
+        // The first frame fills the element hash map, and isn't timed
+        DeclareLayout(0);
+        Clay_EndLayout(0);
+        // Declaring elements always runs on one thread, so Clay_EndLayout() is timed on its own
+        double totalTime = 0;
+        double endLayoutTime = 0;
+        uint64_t hash = 0;
+        for (int32_t frame = 1; frame <= FRAME_COUNT; frame++) {
+            double start = Benchmark_Now();
+            DeclareLayout(frame);
+            double endLayoutStart = Benchmark_Now();
+            Clay_RenderCommandArray renderCommands = Clay_EndLayout(0);
+            double end = Benchmark_Now();
+            totalTime += end - start;
+            endLayoutTime += end - endLayoutStart;
+            if (frame == FRAME_COUNT) {
+                hash = Benchmark_HashRenderCommands(renderCommands);
+            }
+        }
+        Clay_SetLayoutTaskDispatchFunction(NULL, NULL);
+        TaskPool_Stop(&pool);
+
+        endLayoutTime /= FRAME_COUNT;
+        if (threadCount == 1) {
+            singleThreadHash = hash;
+            singleThreadTime = endLayoutTime;
+        }
+        printf("threads %d: %.3f ms/frame, Clay_EndLayout %.3f ms, %.2fx%s\n", threadCount, totalTime / FRAME_COUNT, endLayoutTime, singleThreadTime / endLayoutTime,
+            hash == singleThreadHash ? "" : ", LAYOUT DIFFERS FROM ONE THREAD");
+        if (hash != singleThreadHash) {
+            return 1;
+        }
+    }
+    return 0;
+}
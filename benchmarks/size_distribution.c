@@ -0,0 +1,199 @@
+// Checks that growing and compressing the children of a row matches the loop that Clay used before it sorted child sizes,
+// and measures both on rows with 10,000 children.
+// The old loop stopped once less than CLAY__EPSILON was left to distribute, and moved sizes within CLAY__EPSILON of each other
+// as one tier, so the two are compared with a tolerance of CLAY__EPSILON per child rather than exactly.
+// On rows with thousands of distinct sizes the old loop's running total drifts by far more than that, so those rows are only
+// timed, and how far each method's widths add up from the row's width is reported instead.
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+#include <math.h>
+
+#define MAX_CHILD_COUNT 10000
+#define TRIAL_COUNT 2000
+#define FRAME_COUNT 10
+
+typedef struct {
+    float contentWidth;
+    float minWidth;
+    float maxWidth;
+} Child;
+
+static Child children[MAX_CHILD_COUNT];
+static float expectedWidths[MAX_CHILD_COUNT];
+static int32_t resizableBuffer[MAX_CHILD_COUNT];
+
+// Each child clips its content, so its minimum width is its configured minimum rather than the width of its content
+static void DeclareRow(int32_t childCount, float rowWidth) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("SizeDistribution"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } }, .clip = { .horizontal = true } }) {
+        CLAY(CLAY_ID("DistributionRow"), { .layout = { .sizing = { CLAY_SIZING_FIXED(rowWidth), CLAY_SIZING_FIXED(20) } } }) {
+            for (int32_t i = 0; i < childCount; i++) {
+                Child child = children[i];
+                CLAY(CLAY_IDI("DistributionChild", i), { .layout = { .sizing = { CLAY_SIZING_GROW(child.minWidth, child.maxWidth), CLAY_SIZING_GROW(0) } }, .clip = { .horizontal = true } }) {
+                    CLAY_AUTO_ID({ .layout = { .sizing = { CLAY_SIZING_FIXED(child.contentWidth), CLAY_SIZING_FIXED(10) } } }) {}
+                }
+            }
+        }
+    }
+}
+
+// The grow and compress loops from before sizes were sorted, working on plain arrays instead of layout elements.
+// Every child is a GROW container, so every child takes part in both.
+static void DistributeWithOldLoop(int32_t childCount, float rowWidth) {
+    float innerContentSize = 0;
+    for (int32_t i = 0; i < childCount; i++) {
+        float maxWidth = children[i].maxWidth > 0 ? children[i].maxWidth : CLAY__MAXFLOAT;
+        expectedWidths[i] = CLAY__MIN(CLAY__MAX(children[i].contentWidth, children[i].minWidth), maxWidth);
+        innerContentSize += expectedWidths[i];
+        resizableBuffer[i] = i;
+    }
+    int32_t resizableCount = childCount;
+    float sizeToDistribute = rowWidth - innerContentSize;
+    if (sizeToDistribute < 0) {
+        while (sizeToDistribute < -CLAY__EPSILON && resizableCount > 0) {
+            float largest = 0;
+            float secondLargest = 0;
+            float widthToAdd = sizeToDistribute;
+            for (int32_t childIndex = 0; childIndex < resizableCount; childIndex++) {
+                float childSize = expectedWidths[resizableBuffer[childIndex]];
+                if (Clay__FloatEqual(childSize, largest)) { continue; }
+                if (childSize > largest) {
+                    secondLargest = largest;
+                    largest = childSize;
+                }
+                if (childSize < largest) {
+                    secondLargest = CLAY__MAX(secondLargest, childSize);
+                    widthToAdd = secondLargest - largest;
+                }
+            }
+            widthToAdd = CLAY__MAX(widthToAdd, sizeToDistribute / resizableCount);
+            for (int32_t childIndex = 0; childIndex < resizableCount; childIndex++) {
+                float *childSize = &expectedWidths[resizableBuffer[childIndex]];
+                float minSize = children[resizableBuffer[childIndex]].minWidth;
+                float previousWidth = *childSize;
+                if (Clay__FloatEqual(*childSize, largest)) {
+                    *childSize += widthToAdd;
+                    if (*childSize <= minSize) {
+                        *childSize = minSize;
+                        resizableBuffer[childIndex--] = resizableBuffer[--resizableCount];
+                    }
+                    sizeToDistribute -= (*childSize - previousWidth);
+                }
+            }
+        }
+    } else if (sizeToDistribute > 0) {
+        while (sizeToDistribute > CLAY__EPSILON && resizableCount > 0) {
+            float smallest = CLAY__MAXFLOAT;
+            float secondSmallest = CLAY__MAXFLOAT;
+            float widthToAdd = sizeToDistribute;
+            for (int32_t childIndex = 0; childIndex < resizableCount; childIndex++) {
+                float childSize = expectedWidths[resizableBuffer[childIndex]];
+                if (Clay__FloatEqual(childSize, smallest)) { continue; }
+                if (childSize < smallest) {
+                    secondSmallest = smallest;
+                    smallest = childSize;
+                }
+                if (childSize > smallest) {
+                    secondSmallest = CLAY__MIN(secondSmallest, childSize);
+                    widthToAdd = secondSmallest - smallest;
+                }
+            }
+            widthToAdd = CLAY__MIN(widthToAdd, sizeToDistribute / resizableCount);
+            for (int32_t childIndex = 0; childIndex < resizableCount; childIndex++) {
+                float *childSize = &expectedWidths[resizableBuffer[childIndex]];
+                float maxSize = children[resizableBuffer[childIndex]].maxWidth > 0 ? children[resizableBuffer[childIndex]].maxWidth : CLAY__MAXFLOAT;
+                float previousWidth = *childSize;
+                if (Clay__FloatEqual(*childSize, smallest)) {
+                    *childSize += widthToAdd;
+                    if (*childSize >= maxSize) {
+                        *childSize = maxSize;
+                        resizableBuffer[childIndex--] = resizableBuffer[--resizableCount];
+                    }
+                    sizeToDistribute -= (*childSize - previousWidth);
+                }
+            }
+        }
+    }
+}
+
+// Returns the largest difference between the widths Clay produced and the old loop's, which have to be in expectedWidths
+static float CompareWithOldLoop(int32_t childCount) {
+    float maxDifference = 0;
+    for (int32_t i = 0; i < childCount; i++) {
+        Clay_ElementData data = Clay_GetElementData(CLAY_IDI("DistributionChild", i));
+        if (!data.found) {
+            return CLAY__MAXFLOAT;
+        }
+        maxDifference = CLAY__MAX(maxDifference, fabsf(data.boundingBox.width - expectedWidths[i]));
+    }
+    return maxDifference;
+}
+
+// How far the widths of the children add up from the width of the row, when none of them is held at a limit
+static double RowWidthError(int32_t childCount, float rowWidth, bool fromClay) {
+    double totalWidth = 0;
+    for (int32_t i = 0; i < childCount; i++) {
+        totalWidth += fromClay ? Clay_GetElementData(CLAY_IDI("DistributionChild", i)).boundingBox.width : expectedWidths[i];
+    }
+    return fabs(totalWidth - rowWidth);
+}
+
+// Rounded sizes make ties between children common, and some children have no maximum width
+static void RandomChildren(int32_t childCount) {
+    for (int32_t i = 0; i < childCount; i++) {
+        Child *child = &children[i];
+        child->contentWidth = Benchmark_Random() % 2 ? (float)(Benchmark_Random() % 20 * 10) : (float)(Benchmark_Random() % 20000) / 100.f;
+        child->minWidth = Benchmark_Random() % 3 ? 0 : (float)(Benchmark_Random() % 50);
+        child->maxWidth = Benchmark_Random() % 3 ? 0 : child->minWidth + (float)(Benchmark_Random() % 300);
+    }
+}
+
+int main(void) {
+    // Every child clips, and clipping elements need a config and a scroll container each
+    Clay_SetMaxElementConfigCount(MAX_CHILD_COUNT * 2 + 16);
+    Clay_SetMaxScrollContainerCount(MAX_CHILD_COUNT + 16);
+    Benchmark_Initialize(MAX_CHILD_COUNT * 2 + 16);
+    Clay_SetCullingEnabled(false);
+
+    float maxDifference = 0;
+    for (int32_t trial = 0; trial < TRIAL_COUNT; trial++) {
+        int32_t childCount = 1 + (int32_t)(Benchmark_Random() % 64);
+        RandomChildren(childCount);
+        float contentWidth = 0;
+        for (int32_t i = 0; i < childCount; i++) {
+            contentWidth += children[i].contentWidth;
+        }
+        // Between a third of the content width, which compresses every child, and twice the content width
+        float rowWidth = contentWidth * (float)(33 + Benchmark_Random() % 168) / 100.f;
+        DeclareRow(childCount, rowWidth);
+        Clay_EndLayout(0);
+        DistributeWithOldLoop(childCount, rowWidth);
+        maxDifference = CLAY__MAX(maxDifference, CompareWithOldLoop(childCount));
+    }
+    printf("%d random rows: largest difference from the old loop %.6f, tolerance %.6f\n", TRIAL_COUNT, maxDifference, CLAY__EPSILON);
+    int result = maxDifference <= CLAY__EPSILON ? 0 : 1;
+
+    // Every child has a different content width, so the old loop moved one child per pass.
+    // The content adds up to 4,999,500, which is compressed to a tenth and grown to twice that.
+    for (int32_t i = 0; i < MAX_CHILD_COUNT; i++) {
+        children[i] = CLAY__INIT(Child) { .contentWidth = (float)i * 0.1f };
+    }
+    float rowWidths[] = { 500000, 10000000 };
+    for (int32_t i = 0; i < 2; i++) {
+        double totalTime = 0;
+        for (int32_t frame = 0; frame < FRAME_COUNT; frame++) {
+            DeclareRow(MAX_CHILD_COUNT, rowWidths[i]);
+            double start = Benchmark_Now();
+            Clay_EndLayout(0);
+            totalTime += Benchmark_Now() - start;
+        }
+        double start = Benchmark_Now();
+        DistributeWithOldLoop(MAX_CHILD_COUNT, rowWidths[i]);
+        double oldLoopTime = Benchmark_Now() - start;
+        printf("%s %d children: Clay_EndLayout %.3f ms, old loop alone %.3f ms, widths add up to the row's width within %.3f, old loop within %.3f\n",
+            i == 0 ? "compress" : "grow", MAX_CHILD_COUNT, totalTime / FRAME_COUNT, oldLoopTime,
+            RowWidthError(MAX_CHILD_COUNT, rowWidths[i], true), RowWidthError(MAX_CHILD_COUNT, rowWidths[i], false));
+    }
+    return result;
+}
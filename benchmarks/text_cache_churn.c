@@ -0,0 +1,92 @@
+// Measures wrapping long paragraphs with the text measurement cache, both when the text stays the same and when some of it
+// changes every frame, which frees and allocates runs of measured words all over the cache.
+// Checks that a frame laid out with a churned cache matches the same frame laid out with an empty one.
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#include "benchmark.h"
+#include <stdbool.h>
+
+#define PARAGRAPH_COUNT 100
+#define WORDS_PER_PARAGRAPH 400
+#define CHURNED_PARAGRAPHS_PER_FRAME 20
+#define SOURCE_WORD_COUNT 100000
+#define FRAME_COUNT 100
+
+static const char *words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "sed", "do", "eiusmod", "tempor",
+    "incididunt", "ut", "labore", "et", "dolore", "magna", "aliqua" };
+
+static char sourceText[SOURCE_WORD_COUNT * 12];
+static int32_t sourceWordStarts[SOURCE_WORD_COUNT];
+// The word of the source text that each paragraph starts at. Moving it changes the paragraph's text.
+static int32_t paragraphStartWords[PARAGRAPH_COUNT];
+static const Clay_TextElementConfig textConfig = { .fontSize = 16, .lineHeight = 20, .textColor = { 0, 0, 0, 255 } };
+
+static void GenerateSourceText(void) {
+    int32_t length = 0;
+    for (int32_t i = 0; i < SOURCE_WORD_COUNT; i++) {
+        sourceWordStarts[i] = length;
+        length += snprintf(sourceText + length, sizeof(sourceText) - length, "%s ", words[Benchmark_Random() % (sizeof(words) / sizeof(words[0]))]);
+    }
+}
+
+static Clay_String ParagraphText(int32_t paragraph) {
+    int32_t start = sourceWordStarts[paragraphStartWords[paragraph]];
+    int32_t end = sourceWordStarts[paragraphStartWords[paragraph] + WORDS_PER_PARAGRAPH] - 1;
+    return CLAY__INIT(Clay_String) { .length = end - start, .chars = sourceText + start };
+}
+
+// The window width changes every frame, so every paragraph is wrapped again even if its text hasn't changed
+static void DeclareLayout(int32_t frame) {
+    Clay_SetLayoutDimensions(CLAY__INIT(Clay_Dimensions) { 1920.f + (float)(frame % 13) * 10.f, 1080 });
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("TextCacheChurn"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 16 } }) {
+        for (int32_t column = 0; column < 4; column++) {
+            CLAY(CLAY_IDI("TextColumn", column), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 8 } }) {
+                for (int32_t paragraph = column; paragraph < PARAGRAPH_COUNT; paragraph += 4) {
+                    CLAY_TEXT(ParagraphText(paragraph), textConfig);
+                }
+            }
+        }
+    }
+}
+
+static uint64_t RunFrames(const char *name, bool churn) {
+    double totalTime = 0;
+    uint64_t hash = 0;
+    for (int32_t frame = 0; frame < FRAME_COUNT; frame++) {
+        if (churn) {
+            for (int32_t i = 0; i < CHURNED_PARAGRAPHS_PER_FRAME; i++) {
+                paragraphStartWords[Benchmark_Random() % PARAGRAPH_COUNT] = (int32_t)(((uint32_t)Benchmark_Random() << 16 | Benchmark_Random()) % (SOURCE_WORD_COUNT - WORDS_PER_PARAGRAPH - 1));
+            }
+        }
+        double start = Benchmark_Now();
+        DeclareLayout(frame);
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout(0);
+        totalTime += Benchmark_Now() - start;
+        hash = Benchmark_HashRenderCommands(renderCommands);
+    }
+    printf("%s: %.3f ms/frame\n", name, totalTime / FRAME_COUNT);
+    return hash;
+}
+
+int main(void) {
+    // The text measurement cache holds twice as many words as the element count, so this leaves room for a little over the words
+    // of every paragraph, and churn has to evict and compact
+    Benchmark_Initialize(PARAGRAPH_COUNT * WORDS_PER_PARAGRAPH * 3 / 4);
+    Clay_SetCullingEnabled(false);
+    GenerateSourceText();
+    for (int32_t paragraph = 0; paragraph < PARAGRAPH_COUNT; paragraph++) {
+        paragraphStartWords[paragraph] = paragraph * WORDS_PER_PARAGRAPH;
+    }
+
+    RunFrames("long paragraphs", false);
+    uint64_t churnedHash = RunFrames("long paragraphs, 20% of them changing every frame", true);
+    Clay_ResetMeasureTextCache();
+    DeclareLayout(FRAME_COUNT - 1);
+    uint64_t emptyCacheHash = Benchmark_HashRenderCommands(Clay_EndLayout(0));
+    if (churnedHash != emptyCacheHash) {
+        printf("LAYOUT WITH A CHURNED CACHE DIFFERS FROM AN EMPTY CACHE\n");
+        return 1;
+    }
+    return 0;
+}
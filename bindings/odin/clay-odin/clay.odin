@@ -39,6 +39,7 @@ Arena :: struct {
 	nextAllocation: uintptr,
 	capacity:       c.size_t,
 	memory:         [^]c.char,
+	committedSize:  c.size_t,
 }
 
 BoundingBox :: struct {
@@ -116,6 +117,45 @@ TextElementConfig :: struct {
 	textAlignment: TextAlignment,
 }
 
+TextMeasurementRequest :: struct {
+	text:   StringSlice,
+	config: ^TextElementConfig,
+}
+
+MeasureTextCacheStats :: struct {
+	hits:          u64,
+	misses:        u64,
+	evictions:     u64,
+	itemsResident: i32,
+	wordsResident: i32,
+	bytesResident: u32,
+}
+
+ArrayMemoryUsage :: struct {
+	capacity:      i32,
+	highWaterMark: i32,
+	bytes:         c.size_t,
+}
+
+MemoryUsage :: struct {
+	arenaBytesUsed:        c.size_t,
+	arenaCapacity:         c.size_t,
+	elements:              ArrayMemoryUsage,
+	elementIds:            ArrayMemoryUsage,
+	elementConfigs:        ArrayMemoryUsage,
+	renderCommands:        ArrayMemoryUsage,
+	wrappedTextLines:      ArrayMemoryUsage,
+	pointerOverIds:        ArrayMemoryUsage,
+	dynamicStringData:     ArrayMemoryUsage,
+	scrollContainers:      ArrayMemoryUsage,
+	transitions:           ArrayMemoryUsage,
+	pointerHitGrid:        ArrayMemoryUsage,
+	textMeasurementBatch:  ArrayMemoryUsage,
+	measureTextCacheItems: ArrayMemoryUsage,
+	measuredWords:         ArrayMemoryUsage,
+	warnings:              ArrayMemoryUsage,
+}
+
 AspectRatioElementConfig :: struct {
 	aspectRatio: f32,
 }
@@ -344,6 +384,19 @@ ScrollContainerData :: struct {
 	found:                     bool,
 }
 
+VirtualListConfig :: struct {
+	itemCount:     i32,
+	itemSize:      f32,
+	overscanCount: i32,
+}
+
+VirtualListRange :: struct {
+	startIndex:    i32,
+	endIndex:      i32,
+	leadingSpace:  f32,
+	trailingSpace: f32,
+}
+
 ElementData :: struct {
 	boundingBox: BoundingBox,
 	found:       bool,
@@ -432,6 +485,11 @@ ClayArray :: struct($type: typeid) {
 	internalArray: [^]type,
 }
 
+RenderCommandArray :: struct {
+	using array: ClayArray(RenderCommand),
+	unchanged:   bool,
+}
+
 ElementDeclaration :: struct {
 	layout:          LayoutConfig,
 	backgroundColor: Color,
@@ -457,6 +515,10 @@ ErrorType :: enum EnumBackingType {
 	PercentageOver1,
 	InternalError,
 	UnbalancedOpenClose,
+	HashMapCapacityExceeded,
+	ElementConfigCapacityExceeded,
+	ScrollContainerCapacityExceeded,
+	PointerHitGridCapacityExceeded,
 }
 
 ErrorData :: struct {
@@ -487,28 +549,53 @@ foreign Clay {
 	UpdateScrollContainers :: proc(enableDragScrolling: bool, scrollDelta: Vector2, deltaTime: c.float) ---
 	SetLayoutDimensions :: proc(dimensions: Dimensions) ---
 	BeginLayout :: proc() ---
-	EndLayout :: proc(deltaTime: c.float) -> ClayArray(RenderCommand) ---
+	EndLayout :: proc(deltaTime: c.float) -> RenderCommandArray ---
+	DeclareLayout :: proc(declareLayoutFunction: proc "c" (userData: rawptr), userData: rawptr, deltaTime: c.float) -> RenderCommandArray ---
 	GetOpenElementId :: proc() -> u32 ---
 	GetElementId :: proc(id: String) -> ElementId ---
 	GetElementIdWithIndex :: proc(id: String, index: u32) -> ElementId ---
+	HashStringContents :: proc(text: String) -> u64 ---
 	GetElementData :: proc(id: ElementId) -> ElementData ---
 	Hovered :: proc() -> bool ---
 	OnHover :: proc(onHoverFunction: proc "c" (id: ElementId, pointerData: PointerData, userData: rawptr), userData: rawptr) ---
 	PointerOver :: proc(id: ElementId) -> bool ---
 	GetPointerOverIds :: proc() -> ElementIdArray ---
 	GetScrollOffset :: proc() -> Vector2 ---
+	GetVirtualListRange :: proc(config: VirtualListConfig) -> VirtualListRange ---
 	GetScrollContainerData :: proc(id: ElementId) -> ScrollContainerData ---
 	SetMeasureTextFunction :: proc(measureTextFunction: proc "c" (text: StringSlice, config: ^TextElementConfig, userData: rawptr) -> Dimensions, userData: rawptr) ---
+	SetMeasureTextBatchFunction :: proc(measureTextBatchFunction: proc "c" (requests: [^]TextMeasurementRequest, dimensions: [^]Dimensions, requestCount: i32, userData: rawptr), userData: rawptr) ---
 	SetQueryScrollOffsetFunction :: proc(queryScrollOffsetFunction: proc "c" (elementId: u32, userData: rawptr) -> Vector2, userData: rawptr) ---
+	SetLayoutTaskDispatchFunction :: proc(dispatchFunction: proc "c" (task: proc "c" (taskIndex: i32, taskData: rawptr), taskData: rawptr, taskCount: i32, userData: rawptr), userData: rawptr) ---
 	RenderCommandArray_Get :: proc(array: ^ClayArray(RenderCommand), index: i32) -> ^RenderCommand ---
 	SetDebugModeEnabled :: proc(enabled: bool) ---
 	IsDebugModeEnabled :: proc() -> bool ---
 	SetCullingEnabled :: proc(enabled: bool) ---
+	SetIncrementalLayoutEnabled :: proc(enabled: bool) ---
+	SetFrameReuseEnabled :: proc(enabled: bool) ---
 	GetMaxElementCount :: proc() -> i32 ---
 	SetMaxElementCount :: proc(maxElementCount: i32) ---
 	GetMaxMeasureTextCacheWordCount :: proc() -> i32 ---
 	SetMaxMeasureTextCacheWordCount :: proc(maxMeasureTextCacheWordCount: i32) ---
+	GetMaxElementConfigCount :: proc() -> i32 ---
+	SetMaxElementConfigCount :: proc(maxElementConfigCount: i32) ---
+	GetMaxScrollContainerCount :: proc() -> i32 ---
+	SetMaxScrollContainerCount :: proc(maxScrollContainerCount: i32) ---
+	SetMaxRenderCommandCount :: proc(maxRenderCommandCount: i32) ---
+	SetMaxWrappedTextLineCount :: proc(maxWrappedTextLineCount: i32) ---
+	SetMaxPointerOverIdCount :: proc(maxPointerOverIdCount: i32) ---
+	SetMaxDynamicStringDataSize :: proc(maxDynamicStringDataSize: i32) ---
+	SetMaxTransitionCount :: proc(maxTransitionCount: i32) ---
+	SetMaxTextMeasurementBatchSize :: proc(maxTextMeasurementBatchSize: i32) ---
+	SetMaxPointerHitGridElementCount :: proc(maxPointerHitGridElementCount: i32) ---
+	GetMemoryUsage :: proc() -> MemoryUsage ---
+	SetArenaBlockAllocator :: proc(allocateFunction: proc "c" (size: c.size_t, userData: rawptr) -> rawptr, freeFunction: proc "c" (block: rawptr, size: c.size_t, userData: rawptr), userData: rawptr) ---
 	ResetMeasureTextCache :: proc() ---
+	SetMeasureTextCacheMemoryBudget :: proc(budgetBytes: u32) ---
+	SetMeasureTextCacheRetentionGenerations :: proc(generations: u32) ---
+	GetMeasureTextCacheStats :: proc() -> MeasureTextCacheStats ---
+	ExportMeasureTextCache :: proc(capacity: u32, memory: rawptr, fontSetVersion: u32) -> u32 ---
+	ImportMeasureTextCache :: proc(size: u32, memory: rawptr, fontSetVersion: u32) -> bool ---
 	EaseOut :: proc(arguments: TransitionCallbackArguments) -> bool ---
 }
 
@@ -518,6 +605,7 @@ foreign Clay {
 	_HashString :: proc(key: String, seed: u32) -> ElementId ---
 	_HashStringWithOffset :: proc(key: String, index: u32, seed: u32) -> ElementId ---
 	_OpenTextElement :: proc(text: String, textConfig: TextElementConfig) ---
+	_OpenTextElementWithHash :: proc(text: String, contentsHash: u64, textConfig: TextElementConfig) ---
 }
 
 ConfigureOpenElement :: proc(config: ElementDeclaration) -> bool {
@@ -557,6 +645,10 @@ TextDynamic :: proc(text: string, config: TextElementConfig) {
 	_OpenTextElement(MakeString(text), config)
 }
 
+TextHashed :: proc(text: string, contentsHash: u64, config: TextElementConfig) {
+	_OpenTextElementWithHash(MakeString(text), contentsHash, config)
+}
+
 PaddingAll :: proc(allPadding: u16) -> Padding {
 	return {left = allPadding, right = allPadding, top = allPadding, bottom = allPadding}
 }
@@ -368,7 +368,7 @@ ScrollbarData :: struct {
 scrollbarData := ScrollbarData{}
 animationLerpValue: f32 = -1.0
 
-createLayout :: proc(lerpValue: f32, frametime: f32) -> clay.ClayArray(clay.RenderCommand) {
+createLayout :: proc(lerpValue: f32, frametime: f32) -> clay.RenderCommandArray {
 	mobileScreen := windowWidth < 750
 	clay.BeginLayout()
 	if clay.UI(clay.ID("OuterContainer"))({layout = {layoutDirection = .TopToBottom, sizing = {clay.SizingGrow(), clay.SizingGrow()}}, backgroundColor = COLOR_LIGHT}) {
@@ -10,6 +10,11 @@
     See the examples folder for details.
 */
 
+// mmap() flags such as MAP_ANONYMOUS are hidden by strict standards modes, see Clay_CreateVirtualMemoryArena()
+#if defined(CLAY_VIRTUAL_MEMORY) && defined(CLAY_IMPLEMENTATION) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -76,12 +81,26 @@
 #define CLAY_SIZING_PERCENT(percentOfParent) (CLAY__INIT(Clay_SizingAxis) { .size = { .percent = (percentOfParent) }, .type = CLAY__SIZING_TYPE_PERCENT })
 
 // Note: If a compile error led you here, you might be trying to use CLAY_ID with something other than a string literal. To construct an ID with a dynamic string, use CLAY_SID instead.
+#ifdef __cplusplus
+// In C++ the label is hashed at compile time, see Clay__HashStringConstant()
+#define CLAY_ID(label) CLAY_ID_STATIC(label, Clay__ConstantHash<Clay__FinalizeHashConstant(Clay__HashStringConstant(CLAY__ENSURE_STRING_LITERAL(label), CLAY__STRING_LENGTH(CLAY__ENSURE_STRING_LITERAL(label)), 0))>::value)
+#else
 #define CLAY_ID(label) CLAY_SID(CLAY_STRING(label))
+#endif
 
 #define CLAY_SID(label) Clay__HashString(label, 0)
 
+// Creates the same ID as CLAY_ID(label) from an id value that was calculated ahead of time, so that the label isn't hashed at runtime.
+// The id value is the one returned by Clay_GetElementId(CLAY_STRING(label)).id, i.e. stored in a table generated at build time.
+#define CLAY_ID_STATIC(label, idValue) (CLAY__INIT(Clay_ElementId) { .id = (idValue), .offset = 0, .baseId = (idValue), .stringId = CLAY_STRING(label) })
+
 // Note: If a compile error led you here, you might be trying to use CLAY_IDI with something other than a string literal. To construct an ID with a dynamic string, use CLAY_SIDI instead.
+#ifdef __cplusplus
+// In C++ the label is hashed at compile time, and only the index is added at runtime
+#define CLAY_IDI(label, index) Clay__HashStringBaseWithOffset(CLAY_STRING(label), Clay__ConstantHash<Clay__HashStringConstant(CLAY__ENSURE_STRING_LITERAL(label), CLAY__STRING_LENGTH(CLAY__ENSURE_STRING_LITERAL(label)), 0)>::value, index)
+#else
 #define CLAY_IDI(label, index) CLAY_SIDI(CLAY_STRING(label), index)
+#endif
 
 #define CLAY_SIDI(label, index) Clay__HashStringWithOffset(label, index, 0)
 
@@ -161,6 +180,10 @@ static inline void Clay__SuppressUnusedLatchDefinitionVariableWarning(void) { (v
 
 #define CLAY_TEXT(text, ...) Clay__OpenTextElement(text, CLAY__CONFIG_WRAPPER(Clay_TextElementConfig, __VA_ARGS__))
 
+// Declares text whose contents hash was already calculated with Clay_HashStringContents(), so that large dynamic strings
+// aren't hashed again every frame to look up their measurements. The hash must be recalculated whenever the text changes.
+#define CLAY_TEXT_HASHED(text, contentsHash, ...) Clay__OpenTextElementWithHash(text, contentsHash, CLAY__CONFIG_WRAPPER(Clay_TextElementConfig, __VA_ARGS__))
+
 #ifdef __cplusplus
 
 #define CLAY__INIT(type) type
@@ -220,6 +243,9 @@ typedef struct Clay_Arena {
     uintptr_t nextAllocation;
     size_t capacity;
     char *memory;
+    // How much of memory is readable and writable, for arenas from Clay_CreateVirtualMemoryArena().
+    // Zero for memory that has been fully committed by the caller.
+    size_t committedSize;
 } Clay_Arena;
 
 typedef struct Clay_Dimensions {
@@ -751,6 +777,28 @@ typedef struct Clay_ScrollContainerData {
     bool found;
 } Clay_ScrollContainerData;
 
+// Describes a long list of items inside a scroll container, of which only the visible ones are declared.
+typedef struct Clay_VirtualListConfig {
+    // The total number of items in the list.
+    int32_t itemCount;
+    // The size of each item along the scroll container's layout axis. For items of varying size, an estimate.
+    float itemSize;
+    // The number of extra items to declare on either side of the visible ones, to hide items appearing late while scrolling quickly.
+    int32_t overscanCount;
+} Clay_VirtualListConfig;
+
+// The range of items in a virtual list that should be declared this frame, from Clay_GetVirtualListRange.
+typedef struct Clay_VirtualListRange {
+    // The index of the first item to declare.
+    int32_t startIndex;
+    // One past the index of the last item to declare.
+    int32_t endIndex;
+    // The size of a spacer element to declare before the first item, standing in for the items before it. 0 if no spacer is needed.
+    float leadingSpace;
+    // The size of a spacer element to declare after the last item, standing in for the items after it. 0 if no spacer is needed.
+    float trailingSpace;
+} Clay_VirtualListRange;
+
 // Bounding box and other data for a specific UI element.
 typedef struct Clay_ElementData {
     // The rectangle that encloses this UI element, with the position relative to the root of the layout.
@@ -815,6 +863,9 @@ typedef struct Clay_RenderCommandArray {
     int32_t length;
     // A pointer to the first element in the internal array.
     Clay_RenderCommand* internalArray;
+    // True if frame reuse is enabled and nothing changed since the previous call to Clay_EndLayout().
+    // The render commands are identical to the previous frame's, so renderers can skip drawing entirely.
+    bool unchanged;
 } Clay_RenderCommandArray;
 
 // Represents the current state of interaction with clay this frame.
@@ -894,7 +945,13 @@ typedef CLAY_PACKED_ENUM {
     CLAY_ERROR_TYPE_INTERNAL_ERROR,
     // Clay__OpenElement was called more times than Clay__CloseElement, so there were still remaining open elements when the layout ended.
     CLAY_ERROR_TYPE_UNBALANCED_OPEN_CLOSE,
-    CLAY_ERROR_TYPE_HASH_MAP_CAPACITY_EXCEEDED
+    CLAY_ERROR_TYPE_HASH_MAP_CAPACITY_EXCEEDED,
+    // Clay ran out of capacity in one of its internal arrays for storing optional element configs such as .floating or .border. This limit can be increased with Clay_SetMaxElementConfigCount().
+    CLAY_ERROR_TYPE_ELEMENT_CONFIG_CAPACITY_EXCEEDED,
+    // Clay ran out of capacity in its internal array for storing scroll container state. This limit can be increased with Clay_SetMaxScrollContainerCount().
+    CLAY_ERROR_TYPE_SCROLL_CONTAINER_CAPACITY_EXCEEDED,
+    // The layout has too many elements for the grid that Clay_SetPointerState() uses, so it tests every element instead. This limit can be increased with Clay_SetMaxPointerHitGridElementCount().
+    CLAY_ERROR_TYPE_POINTER_HIT_GRID_CAPACITY_EXCEEDED
 } Clay_ErrorType;
 
 // Data to identify the error that clay has encountered.
@@ -910,6 +967,9 @@ typedef struct Clay_ErrorData {
     // CLAY_ERROR_TYPE_INTERNAL_ERROR - Clay encountered an internal error. It would be wonderful if you could report this so we can fix it!
     // CLAY_ERROR_TYPE_UNBALANCED_OPEN_CLOSE - Clay__OpenElement was called more times than Clay__CloseElement, so there were still remaining open elements when the layout ended.
     // CLAY_ERROR_TYPE_HASH_MAP_CAPACITY_EXCEEDED - Clay ran out of capacity in its internal hash map for storing element IDs -> elements. This limit can be increased with Clay_SetMaxElementCount().
+    // CLAY_ERROR_TYPE_ELEMENT_CONFIG_CAPACITY_EXCEEDED - Clay ran out of capacity in one of its internal arrays for storing optional element configs such as .floating or .border. This limit can be increased with Clay_SetMaxElementConfigCount().
+    // CLAY_ERROR_TYPE_SCROLL_CONTAINER_CAPACITY_EXCEEDED - Clay ran out of capacity in its internal array for storing scroll container state. This limit can be increased with Clay_SetMaxScrollContainerCount().
+    // CLAY_ERROR_TYPE_POINTER_HIT_GRID_CAPACITY_EXCEEDED - The layout has too many elements for the grid that Clay_SetPointerState() uses, so it tests every element instead. This limit can be increased with Clay_SetMaxPointerHitGridElementCount().
     Clay_ErrorType errorType;
     // A string containing human-readable error text that explains the error in more detail.
     Clay_String errorText;
@@ -925,6 +985,90 @@ typedef struct {
     void *userData;
 } Clay_ErrorHandler;
 
+// A user provided function that runs a batch of layout tasks, see Clay_SetLayoutTaskDispatchFunction().
+typedef void (*Clay_LayoutTaskDispatchFunction)(void (*task)(int32_t taskIndex, void *taskData), void *taskData, int32_t taskCount, void *userData);
+
+// A string slice that Clay needs the dimensions of, see Clay_SetMeasureTextBatchFunction().
+typedef struct Clay_TextMeasurementRequest {
+    // A single word without spaces or newlines, or a single space character.
+    Clay_StringSlice text;
+    // The config of the text element that the slice was taken from.
+    Clay_TextElementConfig *config;
+} Clay_TextMeasurementRequest;
+
+// A user provided function that measures a batch of string slices, see Clay_SetMeasureTextBatchFunction().
+typedef void (*Clay_MeasureTextBatchFunction)(Clay_TextMeasurementRequest *requests, Clay_Dimensions *dimensions, int32_t requestCount, void *userData);
+
+// User provided functions that allocate and free the blocks of memory that Clay grows into, see Clay_SetArenaBlockAllocator().
+typedef void *(*Clay_ArenaBlockAllocateFunction)(size_t size, void *userData);
+typedef void (*Clay_ArenaBlockFreeFunction)(void *block, size_t size, void *userData);
+
+// Counters for Clay's internal text measurement cache, returned by Clay_GetMeasureTextCacheStats().
+typedef struct Clay_MeasureTextCacheStats {
+    // The number of cache lookups that found the text already measured. Text is looked up when it's declared, and again while wrapping.
+    uint64_t hits;
+    // The number of cache lookups that had to measure the text.
+    uint64_t misses;
+    // The number of cached texts that were removed because they hadn't been used recently, or to make space for new text.
+    uint64_t evictions;
+    // The number of texts currently stored in the cache.
+    int32_t itemsResident;
+    // The number of measured words and cached wrapped lines currently stored in the cache.
+    int32_t wordsResident;
+    // The memory used by wordsResident, which is what Clay_SetMeasureTextCacheMemoryBudget() limits.
+    uint32_t bytesResident;
+} Clay_MeasureTextCacheStats;
+
+// The memory used by one of Clay's internal arrays, or a group of arrays with the same capacity, see Clay_GetMemoryUsage().
+typedef struct Clay_ArrayMemoryUsage {
+    // The number of items there is room for.
+    int32_t capacity;
+    // The largest number of items that were in use at the end of a frame since Clay_Initialize().
+    int32_t highWaterMark;
+    // The bytes of the arena taken up by the array, or by all of the arrays in the group.
+    size_t bytes;
+} Clay_ArrayMemoryUsage;
+
+// A breakdown of the memory in Clay's arena, returned by Clay_GetMemoryUsage().
+typedef struct Clay_MemoryUsage {
+    // The bytes of the arena that Clay has allocated, including its context and padding.
+    size_t arenaBytesUsed;
+    // The capacity of the arena passed to Clay_Initialize(), or of the block Clay last grew into.
+    size_t arenaCapacity;
+    // Layout elements, and the other per frame arrays that hold one item per element, such as the children of each element, the element
+    // each one is clipped by, and the stacks used to walk the tree. Set with Clay_SetMaxElementCount().
+    Clay_ArrayMemoryUsage elements;
+    // The hash map from element IDs to elements, which keeps elements from the previous frame. Set with Clay_SetMaxElementCount().
+    Clay_ArrayMemoryUsage elementIds;
+    // Each of the pools of optional element configs such as .floating or .border, and the floating element tree roots.
+    // Set with Clay_SetMaxElementConfigCount(), bytes is the total of all of them.
+    Clay_ArrayMemoryUsage elementConfigs;
+    // Set with Clay_SetMaxRenderCommandCount().
+    Clay_ArrayMemoryUsage renderCommands;
+    // Set with Clay_SetMaxWrappedTextLineCount().
+    Clay_ArrayMemoryUsage wrappedTextLines;
+    // Set with Clay_SetMaxPointerOverIdCount().
+    Clay_ArrayMemoryUsage pointerOverIds;
+    // Characters of the strings that Clay generates each frame, which are only used by the debug view.
+    // Set with Clay_SetMaxDynamicStringDataSize().
+    Clay_ArrayMemoryUsage dynamicStringData;
+    // Set with Clay_SetMaxScrollContainerCount().
+    Clay_ArrayMemoryUsage scrollContainers;
+    // Set with Clay_SetMaxTransitionCount().
+    Clay_ArrayMemoryUsage transitions;
+    // The elements that Clay_SetPointerState() finds through its grid. Set with Clay_SetMaxPointerHitGridElementCount().
+    Clay_ArrayMemoryUsage pointerHitGrid;
+    // Texts waiting to be measured and the string slices passed to the batch function, see Clay_SetMeasureTextBatchFunction().
+    // Set with Clay_SetMaxTextMeasurementBatchSize(), the high water mark is the most texts that were deferred in one batch.
+    Clay_ArrayMemoryUsage textMeasurementBatch;
+    // Texts in the text measurement cache, and its hash map. Set with Clay_SetMaxElementCount().
+    Clay_ArrayMemoryUsage measureTextCacheItems;
+    // Measured words and cached wrapped lines in the text measurement cache. Set with Clay_SetMaxMeasureTextCacheWordCount().
+    Clay_ArrayMemoryUsage measuredWords;
+    // Warnings shown in the debug view.
+    Clay_ArrayMemoryUsage warnings;
+} Clay_MemoryUsage;
+
 // Function Forward Declarations ---------------------------------
 
 // Public API functions ------------------------------------------
@@ -959,6 +1103,10 @@ CLAY_DLL_EXPORT void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_
 // Returns the internally stored scroll offset for the currently open element.
 // Generally intended for use with clip elements to create scrolling containers.
 CLAY_DLL_EXPORT Clay_Vector2 Clay_GetScrollOffset(void);
+// Returns the range of items in a virtual list that are visible at the current scroll position of the currently open scroll container.
+// Call this inside the scroll container's declaration, then declare a spacer of leadingSpace, the items from startIndex up to endIndex, and a spacer of trailingSpace.
+// The spacers size the content to the full length of the list, so scrolling, momentum and Clay_GetScrollContainerData behave as if every item was declared.
+CLAY_DLL_EXPORT Clay_VirtualListRange Clay_GetVirtualListRange(Clay_VirtualListConfig config);
 // Updates the layout dimensions in response to the window or outer container being resized.
 CLAY_DLL_EXPORT void Clay_SetLayoutDimensions(Clay_Dimensions dimensions);
 // Returns the current dimensions set by Clay_SetLayoutDimensions.
@@ -968,6 +1116,10 @@ CLAY_DLL_EXPORT void Clay_BeginLayout(void);
 // Called when all layout declarations are finished.
 // Computes the layout and generates and returns the array of render commands to draw.
 CLAY_DLL_EXPORT Clay_RenderCommandArray Clay_EndLayout(float deltaTime);
+// Calls Clay_BeginLayout(), declareLayoutFunction(userData) and Clay_EndLayout(deltaTime), and returns the render commands.
+// When the frame runs out of capacity and a block allocator has been set with Clay_SetArenaBlockAllocator(), Clay grows and calls
+// declareLayoutFunction again, so the frame is laid out in full rather than returning no render commands.
+CLAY_DLL_EXPORT Clay_RenderCommandArray Clay_DeclareLayout(void (*declareLayoutFunction)(void *userData), void *userData, float deltaTime);
 // Gets the ID of the currently open element, useful for retrieving IDs generated by CLAY_AUTO_ID()
 CLAY_DLL_EXPORT uint32_t Clay_GetOpenElementId(void);
 // Calculates a hash ID from the given idString.
@@ -977,6 +1129,9 @@ CLAY_DLL_EXPORT Clay_ElementId Clay_GetElementId(Clay_String idString);
 // - index is used to avoid constructing dynamic ID strings in loops.
 // Generally only used for dynamic strings when CLAY_IDI("stringLiteral", index) can't be used.
 CLAY_DLL_EXPORT Clay_ElementId Clay_GetElementIdWithIndex(Clay_String idString, uint32_t index);
+// Calculates the hash of the contents of text, for use with CLAY_TEXT_HASHED().
+// Generally called once when a large dynamic text buffer changes, rather than every frame.
+CLAY_DLL_EXPORT uint64_t Clay_HashStringContents(Clay_String text);
 // Returns layout data such as the final calculated bounding box for an element with a given ID.
 // The returned Clay_ElementData contains a `found` bool that will be true if an element with the provided ID was found.
 // This ID can be calculated either with CLAY_ID() for string literal IDs, or Clay_GetElementId for dynamic strings.
@@ -1002,9 +1157,22 @@ CLAY_DLL_EXPORT Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_Elemen
 // - measureTextFunction is a user provided function that adheres to the interface Clay_Dimensions (Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
 // - userData is a pointer that will be transparently passed through when the measureTextFunction is called.
 CLAY_DLL_EXPORT void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData), void *userData);
+// Binds a callback function that Clay will call during Clay_EndLayout() with every string slice that isn't in its text measurement cache yet,
+// rather than calling the function from Clay_SetMeasureTextFunction() once per slice as each text element is declared.
+// - measureTextBatchFunction must write the dimensions of requests[i] to dimensions[i] for every i from 0 to requestCount - 1.
+// - userData is a pointer that will be transparently passed through when the measureTextBatchFunction is called.
+// Usually there is a single call per frame, more only happen if a frame has more slices or texts to measure than Clay_SetMaxTextMeasurementBatchSize().
+// Passing NULL goes back to measuring with the function from Clay_SetMeasureTextFunction().
+CLAY_DLL_EXPORT void Clay_SetMeasureTextBatchFunction(Clay_MeasureTextBatchFunction measureTextBatchFunction, void *userData);
 // Experimental - Used in cases where Clay needs to integrate with a system that manages its own scrolling containers externally.
 // Please reach out if you plan to use this function, as it may be subject to change.
 CLAY_DLL_EXPORT void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, void *userData), void *userData);
+// Binds a callback function that Clay will use to size wide levels of the layout tree on multiple threads.
+// - dispatchFunction must call task(taskIndex, taskData) once for every taskIndex from 0 to taskCount - 1, in any order and on any threads,
+//   and must only return once all of them have finished. Passing NULL goes back to sizing everything on the calling thread.
+// - userData is a pointer that will be transparently passed through when the dispatchFunction is called.
+// The tasks only read and write Clay's own memory, and the layout is identical to the single threaded one.
+CLAY_DLL_EXPORT void Clay_SetLayoutTaskDispatchFunction(Clay_LayoutTaskDispatchFunction dispatchFunction, void *userData);
 // A bounds-checked "get" function for the Clay_RenderCommandArray returned from Clay_EndLayout().
 CLAY_DLL_EXPORT Clay_RenderCommand * Clay_RenderCommandArray_Get(Clay_RenderCommandArray* array, int32_t index);
 // Enables and disables Clay's internal debug tools.
@@ -1014,18 +1182,110 @@ CLAY_DLL_EXPORT void Clay_SetDebugModeEnabled(bool enabled);
 CLAY_DLL_EXPORT bool Clay_IsDebugModeEnabled(void);
 // Enables and disables visibility culling. By default, Clay will not generate render commands for elements whose bounding box is entirely outside the screen.
 CLAY_DLL_EXPORT void Clay_SetCullingEnabled(bool enabled);
+// Enables and disables incremental layout. When enabled, Clay fingerprints the sizing related parts of each element's declaration and children,
+// and reuses last frame's sizing for the children of any element whose fingerprint and dimensions haven't changed. Positions and render commands
+// are always recalculated, so the gain depends on how much of a frame is spent sizing; see benchmarks/incremental_layout.c.
+// Incremental layout is suspended for frames in which transitions are running.
+CLAY_DLL_EXPORT void Clay_SetIncrementalLayoutEnabled(bool enabled);
+// Enables and disables frame reuse. When enabled, Clay hashes the element declarations, layout dimensions, pointer and scroll state of each frame.
+// If they match the previous frame, Clay_EndLayout() skips layout and returns the previous render commands with .unchanged set to true.
+// Note that only the pointers to image data, custom data and user data are hashed, not the data they point to.
+CLAY_DLL_EXPORT void Clay_SetFrameReuseEnabled(bool enabled);
 // Returns the maximum number of UI elements supported by Clay's current configuration.
 CLAY_DLL_EXPORT int32_t Clay_GetMaxElementCount(void);
 // Modifies the maximum number of UI elements supported by Clay's current configuration.
-// This may require reallocating additional memory, and re-calling Clay_Initialize();
+// This may require reallocating additional memory, and re-calling Clay_Initialize(), unless Clay_SetArenaBlockAllocator() has been used.
 CLAY_DLL_EXPORT void Clay_SetMaxElementCount(int32_t maxElementCount);
 // Returns the maximum number of measured "words" (whitespace seperated runs of characters) that Clay can store in its internal text measurement cache.
 CLAY_DLL_EXPORT int32_t Clay_GetMaxMeasureTextCacheWordCount(void);
 // Modifies the maximum number of measured "words" (whitespace seperated runs of characters) that Clay can store in its internal text measurement cache.
-// This may require reallocating additional memory, and re-calling Clay_Initialize();
+// This may require reallocating additional memory, and re-calling Clay_Initialize(), unless Clay_SetArenaBlockAllocator() has been used.
 CLAY_DLL_EXPORT void Clay_SetMaxMeasureTextCacheWordCount(int32_t maxMeasureTextCacheWordCount);
+// Returns the maximum number of each type of optional element config (.floating, .clip, .border, .transition, .image, .custom)
+// that Clay can store per frame. Defaults to a quarter of the max element count.
+CLAY_DLL_EXPORT int32_t Clay_GetMaxElementConfigCount(void);
+// Modifies the maximum number of each type of optional element config that Clay can store per frame. Pass 0 to go back to the default.
+// This may require reallocating additional memory, and re-calling Clay_Initialize(), unless Clay_SetArenaBlockAllocator() has been used.
+CLAY_DLL_EXPORT void Clay_SetMaxElementConfigCount(int32_t maxElementConfigCount);
+// Returns the maximum number of scroll containers (elements with .clip set) whose scroll state Clay can track at once.
+// Defaults to 1/32 of the max element count, with a minimum of 100.
+CLAY_DLL_EXPORT int32_t Clay_GetMaxScrollContainerCount(void);
+// Modifies the maximum number of scroll containers whose scroll state Clay can track at once. Pass 0 to go back to the default.
+// This may require reallocating additional memory, and re-calling Clay_Initialize(), unless Clay_SetArenaBlockAllocator() has been used.
+CLAY_DLL_EXPORT void Clay_SetMaxScrollContainerCount(int32_t maxScrollContainerCount);
+// The following capacities default to values that are always large enough, but are usually far larger than needed.
+// Clay_GetMemoryUsage() reports how much of each of them is used, so that they can be set to fit.
+// Pass 0 to any of them to go back to the default. They may require reallocating additional memory, and re-calling Clay_Initialize(),
+// unless Clay_SetArenaBlockAllocator() has been used.
+// Modifies how many render commands Clay can output each frame. Defaults to the max element count.
+// Render commands past the limit are left out, and CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED is reported.
+CLAY_DLL_EXPORT void Clay_SetMaxRenderCommandCount(int32_t maxRenderCommandCount);
+// Modifies how many lines of text Clay can output each frame, after wrapping. Defaults to the max element count.
+// Lines past the limit are left out.
+CLAY_DLL_EXPORT void Clay_SetMaxWrappedTextLineCount(int32_t maxWrappedTextLineCount);
+// Modifies how many elements the pointer can be over at once, see Clay_GetPointerOverIds(). Defaults to the max element count.
+// The innermost elements are left out when there are more than this.
+CLAY_DLL_EXPORT void Clay_SetMaxPointerOverIdCount(int32_t maxPointerOverIdCount);
+// Modifies how many characters of strings the debug view can generate each frame. Defaults to the max element count.
+CLAY_DLL_EXPORT void Clay_SetMaxDynamicStringDataSize(int32_t maxDynamicStringDataSize);
+// Modifies how many elements can have .transition set at once, including elements that are playing an exit transition. Defaults to 200.
+// Transitions past the limit don't play.
+CLAY_DLL_EXPORT void Clay_SetMaxTransitionCount(int32_t maxTransitionCount);
+// Modifies how many string slices Clay passes to the function from Clay_SetMeasureTextBatchFunction() at once, and how many texts it
+// defers measuring until Clay_EndLayout(). Defaults to 1024. Frames with more than this are measured in several batches.
+CLAY_DLL_EXPORT void Clay_SetMaxTextMeasurementBatchSize(int32_t maxTextMeasurementBatchSize);
+// Modifies how many elements Clay_SetPointerState() can find through its grid. Defaults to the max element count, up to 8192.
+// Layouts with more elements than this are hit tested by walking every element, and CLAY_ERROR_TYPE_POINTER_HIT_GRID_CAPACITY_EXCEEDED is reported.
+CLAY_DLL_EXPORT void Clay_SetMaxPointerHitGridElementCount(int32_t maxPointerHitGridElementCount);
+// Returns the capacity, high water mark and size in bytes of each of Clay's internal arrays, so that their capacities can be chosen
+// to fit the UI. High water marks are measured at the end of each frame.
+CLAY_DLL_EXPORT Clay_MemoryUsage Clay_GetMemoryUsage(void);
+// Binds callback functions that Clay will use to grow its internal capacities rather than running out of them.
+// When a frame runs out of elements, element configs, text measurement cache space, scroll containers, transitions or warnings, no
+// capacity error is reported, and a frame that runs out of elements returns no render commands rather than an error message.
+// Declaring frames with Clay_DeclareLayout() instead of Clay_BeginLayout() and Clay_EndLayout() declares them again once Clay has grown.
+// At the start of the next Clay_BeginLayout(), Clay doubles the capacities that ran out, allocates a block big enough for them with allocateFunction, and copies its persistent state (element IDs, scroll positions,
+// transitions and the text measurement cache) across, so nothing is lost. The previous block is passed to freeFunction if it isn't NULL.
+// The memory passed to Clay_Initialize() is never freed, and the context itself stays there, so pointers to it remain valid.
+// Calling Clay_SetMaxElementCount() and the other capacity setters between frames also grows into a new block rather than needing
+// Clay_Initialize() to be called again. Capacities can't be shrunk this way.
+// Elements that are playing an exit transition when Clay grows are removed straight away.
+// - userData is a pointer that will be transparently passed through when allocateFunction and freeFunction are called.
+// Passing NULL for allocateFunction goes back to reporting capacity errors.
+CLAY_DLL_EXPORT void Clay_SetArenaBlockAllocator(Clay_ArenaBlockAllocateFunction allocateFunction, Clay_ArenaBlockFreeFunction freeFunction, void *userData);
+#ifdef CLAY_VIRTUAL_MEMORY
+// Reserves reserveSize bytes of address space for an arena to pass to Clay_Initialize(), without committing memory for it up front.
+// Clay commits pages as it allocates its arrays, and the OS only backs them with physical memory once they are written to, so memory
+// use follows the number of elements that are actually declared rather than the configured capacities.
+// Requires CLAY_VIRTUAL_MEMORY to be defined wherever clay.h is included, and mmap() (Linux and other POSIX systems).
+// - hugePages asks the OS to back the arena with transparent huge pages where it can.
+// Returns an arena with a capacity of zero if the address space couldn't be reserved.
+CLAY_DLL_EXPORT Clay_Arena Clay_CreateVirtualMemoryArena(size_t reserveSize, bool hugePages);
+// Releases the address space reserved by Clay_CreateVirtualMemoryArena(). Clay must no longer be using the arena.
+CLAY_DLL_EXPORT void Clay_FreeVirtualMemoryArena(Clay_Arena arena);
+// Returns the physical memory behind the unused ends of Clay's per frame arrays to the OS, for example after a frame that declared
+// far more elements than usual. Must be called between Clay_EndLayout() and the next Clay_BeginLayout(), and works with any arena
+// whose memory came from mmap() or malloc(). Later frames that need the memory again get fresh pages from the OS.
+CLAY_DLL_EXPORT void Clay_ReleaseUnusedEphemeralMemory(void);
+#endif
 // Resets Clay's internal text measurement cache. Useful if font mappings have changed or fonts have been reloaded.
 CLAY_DLL_EXPORT void Clay_ResetMeasureTextCache(void);
+// Limits the memory that Clay's internal text measurement cache uses for measured words. When new text would go over the budget,
+// text that wasn't used in the current frame is evicted to make space. Text used in the current frame is never evicted, so the budget
+// can be exceeded up to the capacity set with Clay_SetMaxMeasureTextCacheWordCount(). Pass 0 to only limit the cache by that capacity.
+CLAY_DLL_EXPORT void Clay_SetMeasureTextCacheMemoryBudget(uint32_t budgetBytes);
+// Sets how many frames text can go unused before it's removed from Clay's internal text measurement cache. Defaults to 2.
+CLAY_DLL_EXPORT void Clay_SetMeasureTextCacheRetentionGenerations(uint32_t generations);
+// Returns the counters and current size of Clay's internal text measurement cache, which can be used to choose its capacity and budget.
+CLAY_DLL_EXPORT Clay_MeasureTextCacheStats Clay_GetMeasureTextCacheStats(void);
+// Writes the contents of Clay's internal text measurement cache to memory, so that it can be loaded with Clay_ImportMeasureTextCache()
+// the next time the program starts. Returns the number of bytes needed, and only writes them if capacity is at least that large.
+// Returns 0 if the cache is too large to export, which needs more than 4GB.
+// - fontSetVersion is stored with the measurements, and should change whenever the fonts used to measure them change.
+CLAY_DLL_EXPORT uint32_t Clay_ExportMeasureTextCache(uint32_t capacity, void *memory, uint32_t fontSetVersion);
+// Adds the measurements written by Clay_ExportMeasureTextCache() to Clay's internal text measurement cache. The memory must be 4 byte
+// aligned, and is only read during this call. Returns false if the data is invalid, or was exported with a different fontSetVersion.
+CLAY_DLL_EXPORT bool Clay_ImportMeasureTextCache(uint32_t size, const void *memory, uint32_t fontSetVersion);
 // A built in transition function that uses the "Ease Out" curve
 CLAY_DLL_EXPORT bool Clay_EaseOut(Clay_TransitionCallbackArguments arguments);
 
@@ -1038,13 +1298,40 @@ CLAY_DLL_EXPORT void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration
 CLAY_DLL_EXPORT void Clay__CloseElement(void);
 CLAY_DLL_EXPORT Clay_ElementId Clay__HashString(Clay_String key, uint32_t seed);
 CLAY_DLL_EXPORT Clay_ElementId Clay__HashStringWithOffset(Clay_String key, uint32_t offset, uint32_t seed);
+CLAY_DLL_EXPORT Clay_ElementId Clay__HashStringBaseWithOffset(Clay_String key, uint32_t base, uint32_t offset);
 CLAY_DLL_EXPORT void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig textConfig);
+CLAY_DLL_EXPORT void Clay__OpenTextElementWithHash(Clay_String text, uint64_t contentsHash, Clay_TextElementConfig textConfig);
 
 extern Clay_Color Clay__debugViewHighlightColor;
 extern uint32_t Clay__debugViewWidth;
 
 #ifdef __cplusplus
 }
+
+// Compile time versions of the string hash used by Clay__HashString(), so that CLAY_ID() and CLAY_IDI() don't hash string literals every frame.
+// Returns the hash of the characters before it's finalized, which is the base that Clay__HashStringBaseWithOffset() adds an offset to.
+constexpr uint32_t Clay__HashStringConstant(const char *chars, int32_t length, uint32_t seed) {
+    uint32_t hash = seed;
+    for (int32_t i = 0; i < length; i++) {
+        hash += chars[i];
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    return hash;
+}
+
+constexpr uint32_t Clay__FinalizeHashConstant(uint32_t hash) {
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash + 1; // Reserve the hash result of zero as "null id"
+}
+
+// Passing the hash as a template argument guarantees that it's calculated at compile time
+template <uint32_t hash>
+struct Clay__ConstantHash {
+    static constexpr uint32_t value = hash;
+};
 #endif
 
 #endif // CLAY_HEADER
@@ -1055,6 +1342,11 @@ extern uint32_t Clay__debugViewWidth;
 #ifdef CLAY_IMPLEMENTATION
 #undef CLAY_IMPLEMENTATION
 
+#ifdef CLAY_VIRTUAL_MEMORY
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #ifndef CLAY__NULL
 #define CLAY__NULL 0
 #endif
@@ -1149,6 +1441,15 @@ CLAY__ARRAY_DEFINE_FUNCTIONS(typeName, arrayName)   \
 Clay_Context *Clay__currentContext;
 int32_t Clay__defaultMaxElementCount = 8192;
 int32_t Clay__defaultMaxMeasureTextWordCacheCount = 16384;
+int32_t Clay__defaultMaxElementConfigCount = 0;
+int32_t Clay__defaultMaxScrollContainerCount = 0;
+int32_t Clay__defaultMaxRenderCommandCount = 0;
+int32_t Clay__defaultMaxWrappedTextLineCount = 0;
+int32_t Clay__defaultMaxPointerOverIdCount = 0;
+int32_t Clay__defaultMaxDynamicStringDataSize = 0;
+int32_t Clay__defaultMaxTransitionCount = 0;
+int32_t Clay__defaultMaxTextMeasurementBatchSize = 0;
+int32_t Clay__defaultMaxPointerHitGridElementCount = 0;
 
 void Clay__ErrorHandlerFunctionDefault(Clay_ErrorData errorText) {
     (void) errorText;
@@ -1163,6 +1464,16 @@ typedef struct {
     bool maxTextMeasureCacheExceeded;
     bool textMeasurementFunctionNotSet;
     bool hashMapCapacityExceeded;
+    bool elementConfigCapacityExceeded;
+    bool scrollContainerCapacityExceeded;
+    bool measuredWordsCapacityExceeded;
+    bool transitionCapacityExceeded;
+    bool childrenCapacityExceeded;
+    bool warningCapacityExceeded;
+    bool wrappedTextLinesCapacityExceeded;
+    bool pointerOverIdsCapacityExceeded;
+    bool dynamicStringDataCapacityExceeded;
+    bool pointerHitGridCapacityExceeded;
 } Clay_BooleanWarnings;
 
 typedef struct {
@@ -1186,6 +1497,7 @@ bool Clay__Array_AddCapacityCheck(int32_t length, int32_t capacity);
 
 CLAY__ARRAY_DEFINE(bool, Clay__boolArray)
 CLAY__ARRAY_DEFINE(int32_t, Clay__int32_tArray)
+CLAY__ARRAY_DEFINE(float, Clay__floatArray)
 CLAY__ARRAY_DEFINE(char, Clay__charArray)
 CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_ElementId, Clay_ElementIdArray)
 CLAY__ARRAY_DEFINE(Clay_String, Clay__StringArray)
@@ -1200,6 +1512,8 @@ CLAY__ARRAY_DEFINE(Clay__WrappedTextLine, Clay__WrappedTextLineArray)
 
 typedef struct {
     Clay_String text;
+    // The hash of the contents of dynamic text, or 0 if it hasn't been calculated
+    uint64_t contentsHash;
     Clay_Dimensions preferredDimensions;
     Clay__WrappedTextLineArraySlice wrappedLines;
 } Clay__TextElementData;
@@ -1209,20 +1523,23 @@ typedef struct {
     uint16_t length;
 } Clay__LayoutElementChildren;
 
+// Only the data needed by the sizing passes is stored here, the rest of the element's declaration lives
+// in a Clay__LayoutElementData at the same index in a separate array, see Clay__GetLayoutElementData()
 typedef struct Clay_LayoutElement {
     Clay__LayoutElementChildren children;
     Clay_Dimensions dimensions;
     Clay_Dimensions minDimensions;
-    union {
-        Clay_ElementDeclaration config;
-        struct {
-            Clay_TextElementConfig textConfig;
-            Clay__TextElementData textElementData;
-        };
-    };
+    // Copied from the declaration, and modified during layout. Always zero for text elements.
+    Clay_LayoutConfig layout;
+    Clay_AspectRatioElementConfig aspectRatio;
     uint32_t id;
+    // Hash of the sizing related parts of this element's declaration and the fingerprints of its children, used by incremental layout.
+    // Zero means the element's dimensions can't be reused from the previous frame.
+    uint64_t fingerprint;
     uint16_t floatingChildrenCount;
     bool isTextElement;
+    // True if the element is, or contains, a text element that is waiting for Clay_SetMeasureTextBatchFunction() to measure it
+    bool textMeasurementPending;
     // True if the element is currently in an exit transition, and is "synthetic"
     // i.e. data was retained from previous frames
     bool exiting;
@@ -1230,8 +1547,46 @@ typedef struct Clay_LayoutElement {
 
 CLAY__ARRAY_DEFINE(Clay_LayoutElement, Clay_LayoutElementArray)
 
+CLAY__ARRAY_DEFINE(Clay_FloatingElementConfig, Clay__FloatingElementConfigArray)
+CLAY__ARRAY_DEFINE(Clay_ClipElementConfig, Clay__ClipElementConfigArray)
+CLAY__ARRAY_DEFINE(Clay_BorderElementConfig, Clay__BorderElementConfigArray)
+CLAY__ARRAY_DEFINE(Clay_TransitionElementConfig, Clay__TransitionElementConfigArray)
+CLAY__ARRAY_DEFINE(Clay_ImageElementConfig, Clay__ImageElementConfigArray)
+CLAY__ARRAY_DEFINE(Clay_CustomElementConfig, Clay__CustomElementConfigArray)
+
+// Indices into the context's config pools, zero means the element doesn't have that config.
+typedef struct {
+    int32_t floating;
+    int32_t clip;
+    int32_t border;
+    int32_t transition;
+    int32_t image;
+    int32_t custom;
+} Clay__ElementConfigIndices;
+
+// The parts of an element that aren't needed until final layout and render command generation.
+// Most elements only set a few fields of their declaration, so the optional configs are stored in
+// separate pools and only referenced from here, see Clay__GetFloatingConfig() and friends.
+typedef union {
+    struct {
+        Clay_Color backgroundColor;
+        Clay_Color overlayColor;
+        Clay_CornerRadius cornerRadius;
+        void *userData;
+        Clay__ElementConfigIndices configIndices;
+    };
+    struct {
+        Clay_TextElementConfig textConfig;
+        Clay__TextElementData textElementData;
+    };
+} Clay__LayoutElementData;
+
+CLAY__ARRAY_DEFINE(Clay__LayoutElementData, Clay__LayoutElementDataArray)
+
 typedef struct {
     Clay_LayoutElement *layoutElement;
+    // Copied when the container is opened, the pooled config only lives for the frame it was declared in
+    Clay_ClipElementConfig clipConfig;
     Clay_BoundingBox boundingBox;
     Clay_Dimensions contentSize;
     Clay_Vector2 scrollOrigin;
@@ -1266,50 +1621,139 @@ typedef struct Clay__TransitionDataInternal {
 
 CLAY__ARRAY_DEFINE(Clay__TransitionDataInternal, Clay__TransitionDataInternalArray)
 
-typedef struct { // todo get this struct into a single cache line
+// The fields of an element's hash map item that are used while laying out and handling pointers, which fit in a single 64 byte cache line
+// on 64 bit platforms. The rest are stored at the same index in layoutElementsHashMapCold, see Clay__GetHashMapItemCold().
+typedef struct {
     Clay_BoundingBox boundingBox;
-    Clay_ElementId elementId;
     Clay_LayoutElement* layoutElement;
-    void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, void *userData);
-    void *hoverFunctionUserData;
-    int32_t nextIndex;
+    // The fingerprint and final dimensions of the element from the previous frame, used by incremental layout.
+    uint64_t layoutFingerprint;
+    Clay_Dimensions layoutDimensions;
+    uint32_t id;
+    int32_t transitionDataIndex; // Index into transitionDatas, or -1, see Clay__GetTransitionData()
+    int32_t scrollContainerDataIndex; // Index into scrollContainerDatas, or -1, see Clay__GetScrollContainerData()
     uint32_t generation;
     bool appearedThisFrame;
+} Clay_LayoutElementHashMapItem;
+
+CLAY__ARRAY_DEFINE(Clay_LayoutElementHashMapItem, Clay__LayoutElementHashMapItemArray)
+
+typedef struct {
+    Clay_ElementId elementId;
+    void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, void *userData);
+    void *hoverFunctionUserData;
     struct {
         bool collision;
         bool collapsed;
     } debugData;
-} Clay_LayoutElementHashMapItem;
+} Clay__LayoutElementHashMapItemCold;
 
-CLAY__ARRAY_DEFINE(Clay_LayoutElementHashMapItem, Clay__LayoutElementHashMapItemArray)
+CLAY__ARRAY_DEFINE(Clay__LayoutElementHashMapItemCold, Clay__LayoutElementHashMapItemColdArray)
+
+// A slot in the open addressing table that maps element ids to their hash map items. An id of 0 marks an empty slot.
+typedef struct {
+    uint32_t id;
+    int32_t itemIndex;
+} Clay__LayoutElementHashMapSlot;
+
+CLAY__ARRAY_DEFINE(Clay__LayoutElementHashMapSlot, Clay__LayoutElementHashMapSlotArray)
 
 typedef struct {
     int32_t startOffset;
     int32_t length;
     float width;
-    int32_t next;
 } Clay__MeasuredWord;
 
 CLAY__ARRAY_DEFINE(Clay__MeasuredWord, Clay__MeasuredWordArray)
 
 typedef struct {
     Clay_Dimensions unwrappedDimensions;
+    // The words of the text are stored next to each other in Clay_Context.measuredWords
     int32_t measuredWordsStartIndex;
+    int32_t measuredWordsCount;
+    // The lines that the text was last wrapped into, stored as words in Clay_Context.measuredWords, and the container width they were wrapped at.
+    // Lines don't store their height, so they stay valid if only the line height changes.
+    int32_t wrappedLinesStartIndex;
+    int32_t wrappedLinesCount;
+    float wrappedLinesWidth;
     float minWidth;
+    float spaceWidth;
     bool containsNewlines;
+    // The words have been split but not measured yet, see Clay__MeasurePendingText()
+    bool measurementPending;
+    // True if id was made from the address of statically allocated text rather than its contents
+    bool keyedByAddress;
+    // The length and the full hash of the text the words were split from, which are checked on lookup so that a collision of the
+    // 32 bit ids can't apply words to text that they don't fit in
+    int32_t textLength;
+    uint64_t contentsHash;
     // Hash map data
     uint32_t id;
+    // The id that the text would have if it wasn't statically allocated, which stays the same between runs of the program
+    uint32_t contentId;
     int32_t nextIndex;
     uint32_t generation;
 } Clay__MeasureTextCacheItem;
 
 CLAY__ARRAY_DEFINE(Clay__MeasureTextCacheItem, Clay__MeasureTextCacheItemArray)
 
+// The layout of the memory written by Clay_ExportMeasureTextCache(): a header, followed by the items, followed by the words of every
+// item in order. Every field is 4 bytes so that the data can be read in place, e.g. from a memory mapped file.
+#define CLAY__MEASURE_TEXT_CACHE_EXPORT_MAGIC 0x59414c43 // "CLAY" in little endian, so big endian data is rejected
+#define CLAY__MEASURE_TEXT_CACHE_EXPORT_VERSION 2
+
+typedef struct {
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t fontSetVersion;
+    uint32_t itemCount;
+    uint32_t wordCount;
+} Clay__MeasureTextCacheExportHeader;
+
+typedef struct {
+    uint32_t contentId;
+    uint32_t textLength;
+    uint32_t contentsHashLow;
+    uint32_t contentsHashHigh;
+    uint32_t wordCount;
+    Clay_Dimensions unwrappedDimensions;
+    float minWidth;
+    float spaceWidth;
+    uint32_t containsNewlines;
+} Clay__MeasureTextCacheExportItem;
+
+typedef struct {
+    int32_t startOffset;
+    int32_t length;
+    float width;
+} Clay__MeasureTextCacheExportWord;
+
+// A text cache item whose words still need to be measured, along with the text it was split from
+typedef struct {
+    Clay_String text;
+    Clay_TextElementConfig *config;
+    int32_t cacheItemIndex;
+} Clay__PendingTextMeasurement;
+
+CLAY__ARRAY_DEFINE(Clay__PendingTextMeasurement, Clay__PendingTextMeasurementArray)
+
+// Where the result of a Clay_TextMeasurementRequest is stored. A wordIndex of -1 means the request was for the space character.
+typedef struct {
+    int32_t cacheItemIndex;
+    int32_t wordIndex;
+} Clay__TextMeasurementTarget;
+
+CLAY__ARRAY_DEFINE(Clay__TextMeasurementTarget, Clay__TextMeasurementTargetArray)
+CLAY__ARRAY_DEFINE(Clay_TextMeasurementRequest, Clay__TextMeasurementRequestArray)
+CLAY__ARRAY_DEFINE(Clay_Dimensions, Clay__DimensionsArray)
+
 typedef struct {
     Clay_LayoutElement *layoutElement;
     Clay_Vector2 position;
     Clay_Vector2 nextChildOffset;
     bool parentMovedThisFramed; // Used to relativise transitions
+    Clay_BoundingBox clipBoundingBox; // The intersection of the clip regions of all ancestors, outside of which nothing from this element is visible
+    bool culled; // Set when an ancestor clips everything below it, so the whole subtree can skip generating render commands
 } Clay__LayoutElementTreeNode;
 
 CLAY__ARRAY_DEFINE(Clay__LayoutElementTreeNode, Clay__LayoutElementTreeNodeArray)
@@ -1324,9 +1768,38 @@ typedef struct {
 
 CLAY__ARRAY_DEFINE(Clay__LayoutElementTreeRoot, Clay__LayoutElementTreeRootArray)
 
+// The number of cells along each axis of the grid used to find the elements under the pointer
+#define CLAY__POINTER_HIT_GRID_SIZE 16
+
+// Limits for splitting one level of the layout tree into tasks, see Clay_SetLayoutTaskDispatchFunction()
+#define CLAY__LAYOUT_TASK_MAX_COUNT 64
+#define CLAY__LAYOUT_TASK_MIN_CHILD_COUNT 256
+
+// An element that can receive pointer interactions, stored in the order that Clay_SetPointerState visits them
+typedef struct {
+    Clay_LayoutElementHashMapItem *mapItem;
+    Clay_LayoutElementHashMapItem *clipItem; // Null if the element has no clip element
+    int32_t rootIndex;
+    bool rootCapturesPointer;
+} Clay__PointerHitRecord;
+
+CLAY__ARRAY_DEFINE(Clay__PointerHitRecord, Clay__PointerHitRecordArray)
+
 struct Clay_Context {
     int32_t maxElementCount;
     int32_t maxMeasureTextCacheWordCount;
+    int32_t maxElementConfigCount;
+    int32_t maxScrollContainerCount;
+    // Zero means the same as maxElementCount for these
+    int32_t maxRenderCommandCount;
+    int32_t maxWrappedTextLineCount;
+    int32_t maxPointerOverIdCount;
+    int32_t maxDynamicStringDataSize;
+    int32_t maxTransitionCount; // Zero means the default of 200
+    int32_t maxWarningCount; // Zero means the default of 100
+    int32_t maxTextMeasurementBatchSize; // Zero means the default of 1024
+    int32_t maxPointerHitGridElementCount; // Zero means the same as maxElementCount, up to 8192
+    int32_t droppedElementCount; // The number of elements declared after the element capacity ran out this frame
     int32_t exitingElementsLength;
     int32_t exitingElementsChildrenLength;
     bool warningsEnabled;
@@ -1341,52 +1814,182 @@ struct Clay_Context {
     uint32_t dynamicElementIndex;
     bool debugModeEnabled;
     bool disableCulling;
+    bool incrementalLayoutEnabled;
+    bool incrementalLayoutActive;
+    bool frameReuseEnabled;
     bool externalScrollHandlingEnabled;
+    bool textMeasurementDeferred; // True while the user declares the layout, see Clay_SetMeasureTextBatchFunction()
+    bool pointerHitGridDirty; // Set by Clay_EndLayout so that the next Clay_SetPointerState rebuilds the grid
+    bool pointerHitGridValid;
+    Clay_Vector2 pointerHitGridCellSize;
     uint32_t debugSelectedElementId;
     uint32_t generation;
+    uint32_t layoutFingerprintSeed;
+    uint64_t declarationHash;
+    uint64_t previousDeclarationHash; // Zero if the previous frame can't be reused
+    int32_t previousRenderCommandsLength;
     uintptr_t arenaResetOffset;
     void *measureTextUserData;
     void *queryScrollOffsetUserData;
+    Clay_LayoutTaskDispatchFunction layoutTaskDispatchFunction;
+    void *layoutTaskDispatchUserData;
+    Clay_MeasureTextBatchFunction measureTextBatchFunction;
+    void *measureTextBatchUserData;
+    Clay_ArenaBlockAllocateFunction arenaBlockAllocateFunction;
+    Clay_ArenaBlockFreeFunction arenaBlockFreeFunction;
+    void *arenaBlockAllocatorUserData;
+    // The block from arenaBlockAllocateFunction that internalArena currently uses, or NULL if it still uses the memory passed to Clay_Initialize()
+    void *arenaBlock;
+    size_t arenaBlockSize;
+    bool arenaGrowthRequested; // Set by the capacity setters, see Clay__GrowArena()
     Clay_Arena internalArena;
     // Layout Elements / Render Commands
     Clay_LayoutElementArray layoutElements;
+    Clay__LayoutElementDataArray layoutElementData;
+    Clay__FloatingElementConfigArray floatingConfigs;
+    Clay__ClipElementConfigArray clipConfigs;
+    Clay__BorderElementConfigArray borderConfigs;
+    Clay__TransitionElementConfigArray transitionConfigs;
+    Clay__ImageElementConfigArray imageConfigs;
+    Clay__CustomElementConfigArray customConfigs;
     Clay_RenderCommandArray renderCommands;
     Clay__int32_tArray openLayoutElementStack;
     Clay__int32_tArray layoutElementChildren;
     Clay__int32_tArray layoutElementChildrenBuffer;
     Clay__int32_tArray reusableElementIndexBuffer;
     Clay__int32_tArray layoutElementClipElementIds;
+    Clay__PointerHitRecordArray pointerHitRecords;
+    Clay__int32_tArray pointerHitGridCellStarts;
+    Clay__int32_tArray pointerHitGridEntries;
     // Misc Data Structures
     Clay__StringArray layoutElementIdStrings;
     Clay__WrappedTextLineArray wrappedTextLines;
     Clay__LayoutElementTreeNodeArray layoutElementTreeNodeArray1;
     Clay__LayoutElementTreeRootArray layoutElementTreeRoots;
+    Clay__LayoutElementTreeRootArray layoutElementTreeRootsSortBuffer;
     Clay__LayoutElementHashMapItemArray layoutElementsHashMapInternal;
-    Clay__int32_tArray layoutElementsHashMap;
+    Clay__LayoutElementHashMapItemColdArray layoutElementsHashMapCold;
+    Clay__LayoutElementHashMapSlotArray layoutElementsHashMap;
     Clay__int32_tArray layoutElementsHashMapFreeList;
+    // The indexes of every item in layoutElementsHashMapInternal that isn't on the freelist, so that pruning only visits those
+    Clay__int32_tArray layoutElementsHashMapLiveList;
     Clay__MeasureTextCacheItemArray measureTextHashMapInternal;
     Clay__int32_tArray measureTextHashMapInternalFreeList;
     Clay__int32_tArray measureTextHashMap;
     Clay__MeasuredWordArray measuredWords;
-    Clay__int32_tArray measuredWordsFreeList;
+    // The index of the cache item that owns the run of words or wrapped lines starting at each index in measuredWords,
+    // or the negated length of the run if it has been freed
+    Clay__int32_tArray measuredWordRunOwners;
+    int32_t measuredWordsFreeCount;
+    uint32_t measureTextCacheMemoryBudget;
+    uint32_t measureTextCacheRetentionGenerations;
+    // The item that the next search for an item to evict starts after, see Clay__EvictMeasureTextCacheItem()
+    int32_t measureTextCacheClockHand;
+    Clay_MeasureTextCacheStats measureTextCacheStats;
+    // Only the high water marks are kept up to date here, see Clay__UpdateMemoryHighWaterMarks()
+    Clay_MemoryUsage memoryUsage;
+    Clay__PendingTextMeasurementArray pendingTextMeasurements;
+    Clay__TextMeasurementRequestArray textMeasurementRequests;
+    Clay__TextMeasurementTargetArray textMeasurementTargets;
+    Clay__DimensionsArray textMeasurementResults;
     Clay__int32_tArray openClipElementStack;
     Clay_ElementIdArray pointerOverIds;
     Clay__ScrollContainerDataInternalArray scrollContainerDatas;
     Clay__TransitionDataInternalArray transitionDatas;
+    // The lowest indices holding the copies of exiting elements at the end of their arrays, see Clay__CloneElementsWithExitTransition()
+    int32_t exitingElementCopyStart;
+    int32_t exitingChildCopyStart;
+    Clay__ElementConfigIndices exitingConfigCopyStarts;
     Clay__boolArray treeNodeVisited;
     Clay__charArray dynamicStringData;
 };
 
+#ifdef CLAY_VIRTUAL_MEMORY
+// Virtual memory arenas are reserved and committed in steps of this size, which is a multiple of both regular and huge pages
+#define CLAY__VIRTUAL_MEMORY_COMMIT_SIZE ((size_t)2 * 1024 * 1024)
+
+// Makes the reserved pages of a virtual memory arena readable and writable up to the given offset, see Clay_CreateVirtualMemoryArena()
+bool Clay__CommitArena(Clay_Arena *arena, uintptr_t endOffset) {
+    if (arena->committedSize == 0 || endOffset <= arena->committedSize) {
+        return true;
+    }
+    size_t committedSize = (endOffset + CLAY__VIRTUAL_MEMORY_COMMIT_SIZE - 1) & ~(CLAY__VIRTUAL_MEMORY_COMMIT_SIZE - 1);
+    committedSize = CLAY__MIN(committedSize, arena->capacity);
+    if (mprotect(arena->memory + arena->committedSize, committedSize - arena->committedSize, PROT_READ | PROT_WRITE) != 0) {
+        return false;
+    }
+    arena->committedSize = committedSize;
+    return true;
+}
+
+// Zeroes memory in a virtual memory arena by handing its whole pages back to the OS, so that they aren't backed by physical memory
+// until they're next written to. Only the partial pages at either end are cleared by hand.
+void Clay__ZeroVirtualMemory(void *memory, size_t size) {
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    char *start = (char *)memory;
+    char *end = start + size;
+    char *pagesStart = (char *)(((uintptr_t)start + pageSize - 1) & ~(pageSize - 1));
+    char *pagesEnd = (char *)((uintptr_t)end & ~(pageSize - 1));
+    if (pagesEnd <= pagesStart || madvise(pagesStart, pagesEnd - pagesStart, MADV_DONTNEED) != 0) {
+        pagesStart = end;
+        pagesEnd = end;
+    }
+    for (char *byte = start; byte < pagesStart; ++byte) {
+        *byte = 0;
+    }
+    for (char *byte = pagesEnd; byte < end; ++byte) {
+        *byte = 0;
+    }
+}
+#endif
+
 Clay_Context* Clay__Context_Allocate_Arena(Clay_Arena *arena) {
     size_t totalSizeBytes = sizeof(Clay_Context);
     if (totalSizeBytes > arena->capacity)
     {
         return NULL;
     }
+#ifdef CLAY_VIRTUAL_MEMORY
+    if (!Clay__CommitArena(arena, arena->nextAllocation + totalSizeBytes)) {
+        return NULL;
+    }
+#endif
     arena->nextAllocation += totalSizeBytes;
     return (Clay_Context*)(arena->memory);
 }
 
+// Capacities that run out are grown at the start of the next frame when a block allocator has been set, see Clay__GrowArena()
+bool Clay__ArenaCanGrow(void) {
+    return Clay_GetCurrentContext()->arenaBlockAllocateFunction != NULL;
+}
+
+// Called when one of Clay's capacities runs out. If it's going to be grown, the rest of the frame is dropped as if it had run out of
+// elements rather than being laid out with missing configs or text. Returns true if the error should be reported.
+bool Clay__CapacityExceeded(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (Clay__ArenaCanGrow()) {
+        context->booleanWarnings.maxElementsExceeded = true;
+        return false;
+    }
+    return true;
+}
+
+// Lines of text that don't fit in wrappedTextLines are left out, see Clay_SetMaxWrappedTextLineCount()
+void Clay__WrappedTextLinesCapacityExceeded(void) {
+    Clay_GetCurrentContext()->booleanWarnings.wrappedTextLinesCapacityExceeded = true;
+    Clay__CapacityExceeded();
+}
+
+// Children are hit tested after their parents, so when pointerOverIds is full the innermost elements are the ones left out
+void Clay__AddPointerOverId(Clay_ElementId elementId) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->pointerOverIds.length == context->pointerOverIds.capacity) {
+        context->booleanWarnings.pointerOverIdsCapacityExceeded = true;
+        return;
+    }
+    Clay_ElementIdArray_Add(&context->pointerOverIds, elementId);
+}
+
 Clay_String Clay__WriteStringToCharBuffer(Clay__charArray *buffer, Clay_String string) {
     for (int32_t i = 0; i < string.length; i++) {
         buffer->internalArray[buffer->length + i] = string.chars[i];
@@ -1413,6 +2016,94 @@ Clay_LayoutElement* Clay__GetParentElement(void) {
     return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2));
 }
 
+Clay__LayoutElementData* Clay__GetLayoutElementData(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (layoutElement == &Clay_LayoutElement_DEFAULT) {
+        return &Clay__LayoutElementData_DEFAULT;
+    }
+    // Exiting elements are cloned beyond the end of the array, so check against capacity rather than length
+    return Clay__LayoutElementDataArray_GetCheckCapacity(&context->layoutElementData, (int32_t)(layoutElement - context->layoutElements.internalArray));
+}
+
+void Clay__ReportElementConfigCapacityExceeded(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!context->booleanWarnings.elementConfigCapacityExceeded && Clay__CapacityExceeded()) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_ELEMENT_CONFIG_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay ran out of capacity while attempting to store an element config. Try using Clay_SetMaxElementConfigCount() with a higher value."),
+            .userData = context->errorHandler.userData });
+    }
+    context->booleanWarnings.elementConfigCapacityExceeded = true;
+}
+
+// Each optional element config type lives in its own pool. Slot zero of every pool is reserved so that an index of zero means "not set".
+// Clay__GetXConfig() returns the element's config, or a zeroed default if it doesn't have one. The default must not be written to.
+// Clay__AddXConfig() returns the element's config, allocating it first if necessary. Returns NULL if the pool is full.
+// Clay__CopyXConfig() copies the config at index to the end of the pool, or to *tailIndex if it isn't NULL, and returns its new index.
+#define CLAY__ELEMENT_CONFIG_POOL_DEFINE(typeName, arrayName, functionName, poolName)                                                   \
+typeName *Clay__Get##functionName##Config(Clay__LayoutElementData *data) {                                                               \
+    Clay_Context* context = Clay_GetCurrentContext();                                                                                    \
+    int32_t index = data->configIndices.poolName;                                                                                        \
+    /* Exiting elements store their configs beyond the end of the array, so check against capacity rather than length */               \
+    return index ? arrayName##_GetCheckCapacity(&context->poolName##Configs, index) : &typeName##_DEFAULT;                              \
+}                                                                                                                                        \
+                                                                                                                                         \
+typeName *Clay__Add##functionName##Config(Clay__LayoutElementData *data) {                                                               \
+    Clay_Context* context = Clay_GetCurrentContext();                                                                                    \
+    if (data == &Clay__LayoutElementData_DEFAULT) {                                                                                      \
+        return NULL;                                                                                                                     \
+    }                                                                                                                                    \
+    if (!data->configIndices.poolName) {                                                                                                 \
+        if (context->poolName##Configs.length == context->poolName##Configs.capacity) {                                                  \
+            Clay__ReportElementConfigCapacityExceeded();                                                                                 \
+            return NULL;                                                                                                                 \
+        }                                                                                                                                \
+        arrayName##_Add(&context->poolName##Configs, typeName##_DEFAULT);                                                                \
+        data->configIndices.poolName = context->poolName##Configs.length - 1;                                                            \
+    }                                                                                                                                    \
+    return arrayName##_GetCheckCapacity(&context->poolName##Configs, data->configIndices.poolName);                                     \
+}                                                                                                                                        \
+                                                                                                                                         \
+int32_t Clay__Copy##functionName##Config(int32_t index, int32_t *tailIndex) {                                                            \
+    Clay_Context* context = Clay_GetCurrentContext();                                                                                    \
+    if (index == 0) {                                                                                                                    \
+        return 0;                                                                                                                        \
+    }                                                                                                                                    \
+    typeName config = *arrayName##_GetCheckCapacity(&context->poolName##Configs, index);                                                \
+    if (tailIndex) {                                                                                                                     \
+        if (*tailIndex < context->poolName##Configs.length) {                                                                            \
+            Clay__ReportElementConfigCapacityExceeded();                                                                                 \
+            return 0;                                                                                                                    \
+        }                                                                                                                                \
+        arrayName##_Set_DontTouchLength(&context->poolName##Configs, *tailIndex, config);                                                \
+        return (*tailIndex)--;                                                                                                           \
+    }                                                                                                                                    \
+    if (context->poolName##Configs.length == context->poolName##Configs.capacity) {                                                      \
+        Clay__ReportElementConfigCapacityExceeded();                                                                                     \
+        return 0;                                                                                                                        \
+    }                                                                                                                                    \
+    arrayName##_Add(&context->poolName##Configs, config);                                                                                \
+    return context->poolName##Configs.length - 1;                                                                                        \
+}                                                                                                                                        \
+
+CLAY__ELEMENT_CONFIG_POOL_DEFINE(Clay_FloatingElementConfig, Clay__FloatingElementConfigArray, Floating, floating)
+CLAY__ELEMENT_CONFIG_POOL_DEFINE(Clay_ClipElementConfig, Clay__ClipElementConfigArray, Clip, clip)
+CLAY__ELEMENT_CONFIG_POOL_DEFINE(Clay_BorderElementConfig, Clay__BorderElementConfigArray, Border, border)
+CLAY__ELEMENT_CONFIG_POOL_DEFINE(Clay_TransitionElementConfig, Clay__TransitionElementConfigArray, Transition, transition)
+CLAY__ELEMENT_CONFIG_POOL_DEFINE(Clay_ImageElementConfig, Clay__ImageElementConfigArray, Image, image)
+CLAY__ELEMENT_CONFIG_POOL_DEFINE(Clay_CustomElementConfig, Clay__CustomElementConfigArray, Custom, custom)
+
+// Copies the optional configs referenced by an element into new pool slots, see Clay__CopyXConfig()
+void Clay__CopyElementConfigs(Clay__LayoutElementData *data, Clay__ElementConfigIndices *tailIndices) {
+    Clay__ElementConfigIndices *indices = &data->configIndices;
+    indices->floating = Clay__CopyFloatingConfig(indices->floating, tailIndices ? &tailIndices->floating : NULL);
+    indices->clip = Clay__CopyClipConfig(indices->clip, tailIndices ? &tailIndices->clip : NULL);
+    indices->border = Clay__CopyBorderConfig(indices->border, tailIndices ? &tailIndices->border : NULL);
+    indices->transition = Clay__CopyTransitionConfig(indices->transition, tailIndices ? &tailIndices->transition : NULL);
+    indices->image = Clay__CopyImageConfig(indices->image, tailIndices ? &tailIndices->image : NULL);
+    indices->custom = Clay__CopyCustomConfig(indices->custom, tailIndices ? &tailIndices->custom : NULL);
+}
+
 uint32_t Clay__GetParentElementId(void) {
     return Clay__GetParentElement()->id;
 }
@@ -1449,7 +2140,6 @@ Clay_ElementId Clay__HashString(Clay_String key, const uint32_t seed) {
 }
 
 Clay_ElementId Clay__HashStringWithOffset(Clay_String key, const uint32_t offset, const uint32_t seed) {
-    uint32_t hash = 0;
     uint32_t base = seed;
 
     for (int32_t i = 0; i < key.length; i++) {
@@ -1457,7 +2147,12 @@ Clay_ElementId Clay__HashStringWithOffset(Clay_String key, const uint32_t offset
         base += (base << 10);
         base ^= (base >> 6);
     }
-    hash = base;
+    return Clay__HashStringBaseWithOffset(key, base, offset);
+}
+
+// Finishes Clay__HashStringWithOffset() from the hash of the characters in key, which can be calculated ahead of time
+Clay_ElementId Clay__HashStringBaseWithOffset(Clay_String key, uint32_t base, const uint32_t offset) {
+    uint32_t hash = base;
     hash += offset;
     hash += (hash << 10);
     hash ^= (hash >> 6);
@@ -1591,7 +2286,7 @@ uint64_t Clay__HashData(const uint8_t* data, size_t length) {
 }
 #endif
 
-uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, Clay_TextElementConfig *config) {
+uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, uint64_t contentsHash, Clay_TextElementConfig *config) {
     uint32_t hash = 0;
     if (text->isStaticallyAllocated) {
         hash += (uintptr_t)text->chars;
@@ -1601,7 +2296,10 @@ uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, Clay_TextElementC
         hash += (hash << 10);
         hash ^= (hash >> 6);
     } else {
-        hash = Clay__HashData((const uint8_t *)text->chars, text->length) % UINT32_MAX;
+        if (contentsHash == 0) {
+            contentsHash = Clay__HashData((const uint8_t *)text->chars, text->length);
+        }
+        hash = contentsHash % UINT32_MAX;
     }
 
     hash += config->fontId;
@@ -1622,324 +2320,971 @@ uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, Clay_TextElementC
     return hash + 1; // Reserve the hash result of zero as "null id"
 }
 
-Clay__MeasuredWord *Clay__AddMeasuredWord(Clay__MeasuredWord word, Clay__MeasuredWord *previousWord) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    if (context->measuredWordsFreeList.length > 0) {
-        uint32_t newItemIndex = Clay__int32_tArray_GetValue(&context->measuredWordsFreeList, (int)context->measuredWordsFreeList.length - 1);
-        context->measuredWordsFreeList.length--;
-        Clay__MeasuredWordArray_Set(&context->measuredWords, (int)newItemIndex, word);
-        previousWord->next = (int32_t)newItemIndex;
-        return Clay__MeasuredWordArray_Get(&context->measuredWords, (int)newItemIndex);
-    } else {
-        previousWord->next = (int32_t)context->measuredWords.length;
-        return Clay__MeasuredWordArray_Add(&context->measuredWords, word);
-    }
+uint64_t Clay__MixFingerprint(uint64_t hash, uint64_t value) {
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    return hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
 }
 
-Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_TextElementConfig *config) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    #ifndef CLAY_WASM
-    if (!Clay__MeasureText) {
-        if (!context->booleanWarnings.textMeasurementFunctionNotSet) {
-            context->booleanWarnings.textMeasurementFunctionNotSet = true;
-            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_FUNCTION_NOT_PROVIDED,
-                    .errorText = CLAY_STRING("Clay's internal MeasureText function is null. You may have forgotten to call Clay_SetMeasureTextFunction(), or passed a NULL function pointer by mistake."),
-                    .userData = context->errorHandler.userData });
-        }
-        return &Clay__MeasureTextCacheItem_DEFAULT;
-    }
-    #endif
-    uint32_t id = Clay__HashStringContentsWithConfig(text, config);
-    uint32_t hashBucket = id % (context->maxMeasureTextCacheWordCount / 32);
-    int32_t elementIndexPrevious = 0;
-    int32_t elementIndex = context->measureTextHashMap.internalArray[hashBucket];
-    while (elementIndex != 0) {
-        Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex);
-        if (hashEntry->id == id) {
-            hashEntry->generation = context->generation;
-            return hashEntry;
-        }
-        // This element hasn't been seen in a few frames, delete the hash map item
-        if (context->generation - hashEntry->generation > 2) {
-            // Add all the measured words that were included in this measurement to the freelist
-            int32_t nextWordIndex = hashEntry->measuredWordsStartIndex;
-            while (nextWordIndex != -1) {
-                Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, nextWordIndex);
-                Clay__int32_tArray_Add(&context->measuredWordsFreeList, nextWordIndex);
-                nextWordIndex = measuredWord->next;
-            }
+uint64_t Clay__MixFingerprintFloat(uint64_t hash, float value) {
+    union { float value; uint32_t bits; } floatBits;
+    floatBits.value = value;
+    return Clay__MixFingerprint(hash, floatBits.bits);
+}
 
-            int32_t nextIndex = hashEntry->nextIndex;
-            Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, elementIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1 });
-            Clay__int32_tArray_Add(&context->measureTextHashMapInternalFreeList, elementIndex);
-            if (elementIndexPrevious == 0) {
-                context->measureTextHashMap.internalArray[hashBucket] = nextIndex;
-            } else {
-                Clay__MeasureTextCacheItem *previousHashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious);
-                previousHashEntry->nextIndex = nextIndex;
-            }
-            elementIndex = nextIndex;
-        } else {
-            elementIndexPrevious = elementIndex;
-            elementIndex = hashEntry->nextIndex;
-        }
-    }
+uint64_t Clay__MixFingerprintColor(uint64_t hash, Clay_Color color) {
+    hash = Clay__MixFingerprintFloat(hash, color.r);
+    hash = Clay__MixFingerprintFloat(hash, color.g);
+    hash = Clay__MixFingerprintFloat(hash, color.b);
+    return Clay__MixFingerprintFloat(hash, color.a);
+}
 
-    int32_t newItemIndex = 0;
-    Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .id = id, .generation = context->generation };
-    Clay__MeasureTextCacheItem *measured = NULL;
-    if (context->measureTextHashMapInternalFreeList.length > 0) {
-        newItemIndex = Clay__int32_tArray_GetValue(&context->measureTextHashMapInternalFreeList, context->measureTextHashMapInternalFreeList.length - 1);
-        context->measureTextHashMapInternalFreeList.length--;
-        Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, newItemIndex, newCacheItem);
-        measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, newItemIndex);
-    } else {
-        if (context->measureTextHashMapInternal.length == context->measureTextHashMapInternal.capacity - 1) {
-            if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
-                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                        .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
-                        .errorText = CLAY_STRING("Clay ran out of capacity while attempting to measure text elements. Try using Clay_SetMaxElementCount() with a higher value."),
-                        .userData = context->errorHandler.userData });
-                context->booleanWarnings.maxTextMeasureCacheExceeded = true;
-            }
-            return &Clay__MeasureTextCacheItem_DEFAULT;
-        }
-        measured = Clay__MeasureTextCacheItemArray_Add(&context->measureTextHashMapInternal, newCacheItem);
-        newItemIndex = context->measureTextHashMapInternal.length - 1;
+uint64_t Clay__MixFingerprintSizingAxis(uint64_t hash, Clay_SizingAxis sizing) {
+    hash = Clay__MixFingerprint(hash, sizing.type);
+    // Only the union member that matches the sizing type is initialized
+    if (sizing.type == CLAY__SIZING_TYPE_PERCENT) {
+        return Clay__MixFingerprintFloat(hash, sizing.size.percent);
     }
+    hash = Clay__MixFingerprintFloat(hash, sizing.size.minMax.min);
+    return Clay__MixFingerprintFloat(hash, sizing.size.minMax.max);
+}
 
-    int32_t start = 0;
-    int32_t end = 0;
-    float lineWidth = 0;
-    float measuredWidth = 0;
-    float measuredHeight = 0;
-    float spaceWidth = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, config, context->measureTextUserData).width;
-    Clay__MeasuredWord tempWord = { .next = -1 };
-    Clay__MeasuredWord *previousWord = &tempWord;
-    while (end < text->length) {
-        if (context->measuredWords.length == context->measuredWords.capacity - 1) {
-            if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
-                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
-                    .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
-                    .userData = context->errorHandler.userData });
-                context->booleanWarnings.maxTextMeasureCacheExceeded = true;
-            }
-            return &Clay__MeasureTextCacheItem_DEFAULT;
-        }
-        char current = text->chars[end];
-        if (current == ' ' || current == '\n') {
-            int32_t length = end - start;
-            Clay_Dimensions dimensions = CLAY__DEFAULT_STRUCT;
-            if (length > 0) {
-                dimensions = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) {.length = length, .chars = &text->chars[start], .baseChars = text->chars}, config, context->measureTextUserData);
-            }
-            measured->minWidth = CLAY__MAX(dimensions.width, measured->minWidth);
-            measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
-            if (current == ' ') {
-                dimensions.width += spaceWidth;
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = dimensions.width, .next = -1 }, previousWord);
-                lineWidth += dimensions.width;
-            }
-            if (current == '\n') {
-                if (length > 0) {
-                    previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = dimensions.width, .next = -1 }, previousWord);
-                }
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0, .next = -1 }, previousWord);
-                lineWidth += dimensions.width;
-                measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
-                measured->containsNewlines = true;
-                lineWidth = 0;
-            }
-            start = end + 1;
-        }
-        end++;
-    }
-    if (end - start > 0) {
-        Clay_Dimensions dimensions = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = end - start, .chars = &text->chars[start], .baseChars = text->chars }, config, context->measureTextUserData);
-        Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start, .width = dimensions.width, .next = -1 }, previousWord);
-        lineWidth += dimensions.width;
-        measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
-        measured->minWidth = CLAY__MAX(dimensions.width, measured->minWidth);
-    }
-    measuredWidth = CLAY__MAX(lineWidth, measuredWidth) - config->letterSpacing;
+#define CLAY__MIX_FINGERPRINT_POINTER(hash, pointer) Clay__MixFingerprint(hash, (uint64_t)(uintptr_t)(pointer))
+
+// Configs are hashed one field at a time, as the padding between their fields isn't guaranteed to be initialized
+uint64_t Clay__HashTextElementConfig(uint64_t hash, const Clay_TextElementConfig *config) {
+    hash = CLAY__MIX_FINGERPRINT_POINTER(hash, config->userData);
+    hash = Clay__MixFingerprintColor(hash, config->textColor);
+    hash = Clay__MixFingerprint(hash, config->fontId);
+    hash = Clay__MixFingerprint(hash, config->fontSize);
+    hash = Clay__MixFingerprint(hash, config->letterSpacing);
+    hash = Clay__MixFingerprint(hash, config->lineHeight);
+    hash = Clay__MixFingerprint(hash, config->wrapMode);
+    return Clay__MixFingerprint(hash, config->textAlignment);
+}
 
-    measured->measuredWordsStartIndex = tempWord.next;
-    measured->unwrappedDimensions.width = measuredWidth;
-    measured->unwrappedDimensions.height = measuredHeight;
+uint64_t Clay__HashElementDeclaration(const Clay_ElementDeclaration *declaration) {
+    const Clay_LayoutConfig *layout = &declaration->layout;
+    uint64_t hash = Clay__MixFingerprintSizingAxis(0, layout->sizing.width);
+    hash = Clay__MixFingerprintSizingAxis(hash, layout->sizing.height);
+    hash = Clay__MixFingerprint(hash, layout->padding.left);
+    hash = Clay__MixFingerprint(hash, layout->padding.right);
+    hash = Clay__MixFingerprint(hash, layout->padding.top);
+    hash = Clay__MixFingerprint(hash, layout->padding.bottom);
+    hash = Clay__MixFingerprint(hash, layout->childGap);
+    hash = Clay__MixFingerprint(hash, layout->childAlignment.x);
+    hash = Clay__MixFingerprint(hash, layout->childAlignment.y);
+    hash = Clay__MixFingerprint(hash, layout->layoutDirection);
+    hash = Clay__MixFingerprintColor(hash, declaration->backgroundColor);
+    hash = Clay__MixFingerprintColor(hash, declaration->overlayColor);
+    hash = Clay__MixFingerprintFloat(hash, declaration->cornerRadius.topLeft);
+    hash = Clay__MixFingerprintFloat(hash, declaration->cornerRadius.topRight);
+    hash = Clay__MixFingerprintFloat(hash, declaration->cornerRadius.bottomLeft);
+    hash = Clay__MixFingerprintFloat(hash, declaration->cornerRadius.bottomRight);
+    hash = Clay__MixFingerprintFloat(hash, declaration->aspectRatio.aspectRatio);
+    hash = CLAY__MIX_FINGERPRINT_POINTER(hash, declaration->image.imageData);
+    const Clay_FloatingElementConfig *floating = &declaration->floating;
+    hash = Clay__MixFingerprintFloat(hash, floating->offset.x);
+    hash = Clay__MixFingerprintFloat(hash, floating->offset.y);
+    hash = Clay__MixFingerprintFloat(hash, floating->expand.width);
+    hash = Clay__MixFingerprintFloat(hash, floating->expand.height);
+    hash = Clay__MixFingerprint(hash, floating->parentId);
+    hash = Clay__MixFingerprint(hash, (uint16_t)floating->zIndex);
+    hash = Clay__MixFingerprint(hash, floating->attachPoints.element);
+    hash = Clay__MixFingerprint(hash, floating->attachPoints.parent);
+    hash = Clay__MixFingerprint(hash, floating->pointerCaptureMode);
+    hash = Clay__MixFingerprint(hash, floating->attachTo);
+    hash = Clay__MixFingerprint(hash, floating->clipTo);
+    hash = CLAY__MIX_FINGERPRINT_POINTER(hash, declaration->custom.customData);
+    hash = Clay__MixFingerprint(hash, declaration->clip.horizontal);
+    hash = Clay__MixFingerprint(hash, declaration->clip.vertical);
+    hash = Clay__MixFingerprintFloat(hash, declaration->clip.childOffset.x);
+    hash = Clay__MixFingerprintFloat(hash, declaration->clip.childOffset.y);
+    hash = Clay__MixFingerprintColor(hash, declaration->border.color);
+    hash = Clay__MixFingerprint(hash, declaration->border.width.left);
+    hash = Clay__MixFingerprint(hash, declaration->border.width.right);
+    hash = Clay__MixFingerprint(hash, declaration->border.width.top);
+    hash = Clay__MixFingerprint(hash, declaration->border.width.bottom);
+    hash = Clay__MixFingerprint(hash, declaration->border.width.betweenChildren);
+    const Clay_TransitionElementConfig *transition = &declaration->transition;
+    hash = CLAY__MIX_FINGERPRINT_POINTER(hash, transition->handler);
+    hash = Clay__MixFingerprintFloat(hash, transition->duration);
+    hash = Clay__MixFingerprint(hash, transition->properties);
+    hash = Clay__MixFingerprint(hash, transition->interactionHandling);
+    hash = CLAY__MIX_FINGERPRINT_POINTER(hash, transition->enter.setInitialState);
+    hash = Clay__MixFingerprint(hash, transition->enter.trigger);
+    hash = CLAY__MIX_FINGERPRINT_POINTER(hash, transition->exit.setFinalState);
+    hash = Clay__MixFingerprint(hash, transition->exit.trigger);
+    hash = Clay__MixFingerprint(hash, transition->exit.siblingOrdering);
+    return CLAY__MIX_FINGERPRINT_POINTER(hash, declaration->userData);
+}
 
-    if (elementIndexPrevious != 0) {
-        Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious)->nextIndex = newItemIndex;
-    } else {
-        context->measureTextHashMap.internalArray[hashBucket] = newItemIndex;
-    }
-    return measured;
+// Incremental layout only reuses sizes, so its fingerprints only hash the parts of a declaration that sizing reads.
+// Colors, borders, pointers, alignment and floating offsets only change positions and render commands, which are always recalculated.
+// Small fields are packed together to keep the number of mixes per element low.
+uint64_t Clay__HashTextElementLayout(uint64_t hash, const Clay_TextElementConfig *config) {
+    hash = Clay__MixFingerprint(hash, (uint64_t)config->fontId | (uint64_t)config->fontSize << 16 | (uint64_t)config->letterSpacing << 32 | (uint64_t)config->lineHeight << 48);
+    return Clay__MixFingerprint(hash, config->wrapMode);
 }
 
-bool Clay__PointIsInsideRect(Clay_Vector2 point, Clay_BoundingBox rect) {
-    return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
+uint64_t Clay__HashElementLayout(const Clay_ElementDeclaration *declaration) {
+    const Clay_LayoutConfig *layout = &declaration->layout;
+    uint64_t hash = Clay__MixFingerprintSizingAxis(0, layout->sizing.width);
+    hash = Clay__MixFingerprintSizingAxis(hash, layout->sizing.height);
+    hash = Clay__MixFingerprint(hash, (uint64_t)layout->padding.left | (uint64_t)layout->padding.right << 16 | (uint64_t)layout->padding.top << 32 | (uint64_t)layout->padding.bottom << 48);
+    return Clay__MixFingerprint(hash, (uint64_t)layout->childGap | (uint64_t)layout->layoutDirection << 16 | (uint64_t)declaration->clip.horizontal << 24
+        | (uint64_t)declaration->clip.vertical << 25 | (uint64_t)declaration->floating.attachTo << 32);
 }
 
-Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Clay_LayoutElement* layoutElement) {
+void Clay__AddToDeclarationHash(uint64_t value) {
     Clay_Context* context = Clay_GetCurrentContext();
-    if (context->layoutElementsHashMapInternal.length == context->layoutElementsHashMapInternal.capacity - 1) {
-        if (!context->booleanWarnings.hashMapCapacityExceeded) {
-            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                .errorType = CLAY_ERROR_TYPE_HASH_MAP_CAPACITY_EXCEEDED,
-                .errorText = CLAY_STRING("Clay has run out of space in it's internal element ID hashmap.  Try using Clay_SetMaxElementCount() with a higher value."),
-                .userData = context->errorHandler.userData });
-            context->booleanWarnings.hashMapCapacityExceeded = true;
+    context->declarationHash = Clay__MixFingerprint(context->declarationHash, value);
+}
+
+// Moves the runs of all live cache items to the start of the measured words array, removing the gaps left by freed runs
+void Clay__CompactMeasuredWords(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t *runOwners = context->measuredWordRunOwners.internalArray;
+    int32_t writeIndex = 0;
+    int32_t readIndex = 0;
+    while (readIndex < context->measuredWords.length) {
+        int32_t owner = runOwners[readIndex];
+        if (owner < 0) {
+            readIndex -= owner;
+            continue;
         }
-        return NULL;
-    }
-    Clay_LayoutElementHashMapItem item = { .elementId = elementId, .layoutElement = layoutElement, .nextIndex = -1, .generation = context->generation + 1, .appearedThisFrame = true };
-    uint32_t hashBucket = elementId.id % context->layoutElementsHashMap.capacity;
-    int32_t hashItemPrevious = -1;
-    int32_t hashItemIndex = context->layoutElementsHashMap.internalArray[hashBucket];
-    while (hashItemIndex != -1) { // Just replace collision, not a big deal - leave it up to the end user
-        Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, hashItemIndex);
-        if (hashItem->elementId.id == elementId.id) { // Collision - resolve based on generation
-            item.nextIndex = hashItem->nextIndex;
-            if (hashItem->generation <= context->generation) { // First collision - assume this is the "same" element
-                hashItem->appearedThisFrame = hashItem->generation < context->generation;
-                hashItem->elementId = elementId; // Make sure to copy this across. If the stringId reference has changed, we should update the hash item to use the new one.
-                hashItem->generation = context->generation + 1;
-                hashItem->layoutElement = layoutElement;
-                hashItem->debugData.collision = false;
-                hashItem->onHoverFunction = NULL;
-                hashItem->hoverFunctionUserData = 0;
-            } else { // Multiple collisions this frame - two elements have the same ID
-                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_DUPLICATE_ID,
-                    .errorText = CLAY_STRING("An element with this ID was already previously declared during this layout."),
-                    .userData = context->errorHandler.userData });
-                if (context->debugModeEnabled) {
-                    hashItem->debugData.collision = true;
-                }
+        Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, owner);
+        int32_t *runStartIndex = &item->measuredWordsStartIndex;
+        int32_t runCount = item->measuredWordsCount;
+        if (item->wrappedLinesCount > 0 && item->wrappedLinesStartIndex == readIndex) {
+            runStartIndex = &item->wrappedLinesStartIndex;
+            runCount = item->wrappedLinesCount;
+        }
+        if (writeIndex != readIndex) {
+            for (int32_t i = 0; i < runCount; ++i) {
+                context->measuredWords.internalArray[writeIndex + i] = context->measuredWords.internalArray[readIndex + i];
             }
-            return hashItem;
+            runOwners[writeIndex] = owner;
+            *runStartIndex = writeIndex;
         }
-        hashItemPrevious = hashItemIndex;
-        hashItemIndex = hashItem->nextIndex;
+        writeIndex += runCount;
+        readIndex += runCount;
     }
+    context->measuredWords.length = writeIndex;
+    context->measuredWordsFreeCount = 0;
+}
 
-    int32_t indexToUse = 0;
-    if (context->layoutElementsHashMapFreeList.length > 0) {
-        indexToUse = Clay__int32_tArray_GetValue(&context->layoutElementsHashMapFreeList, context->layoutElementsHashMapFreeList.length - 1);
-        context->layoutElementsHashMapFreeList.length--;
-    } else {
-        indexToUse = context->layoutElementsHashMapInternal.length;
+void Clay__FreeMeasuredWordRun(int32_t startIndex, int32_t count) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (count == 0) {
+        return;
     }
-    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Set(&context->layoutElementsHashMapInternal, indexToUse, item);
-    if (hashItemPrevious != -1) {
-        Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, hashItemPrevious)->nextIndex = (int32_t)indexToUse;
+    if (startIndex + count == context->measuredWords.length) {
+        context->measuredWords.length = startIndex;
     } else {
-        context->layoutElementsHashMap.internalArray[hashBucket] = (int32_t)indexToUse;
+        // The space is reclaimed by Clay__CompactMeasuredWords()
+        context->measuredWordRunOwners.internalArray[startIndex] = -count;
+        context->measuredWordsFreeCount += count;
     }
-    return hashItem;
 }
 
-Clay_LayoutElementHashMapItem *Clay__GetHashMapItem(uint32_t id) {
+// Appends a word to the run of the cache item, which must be the last run in the measured words array.
+// Space for the word must have been reserved with Clay__ReserveMeasuredWords().
+void Clay__AddMeasuredWord(int32_t itemIndex, Clay__MeasuredWord word) {
     Clay_Context* context = Clay_GetCurrentContext();
-    uint32_t hashBucket = id % context->layoutElementsHashMap.capacity;
-    int32_t elementIndex = context->layoutElementsHashMap.internalArray[hashBucket];
-    while (elementIndex != -1) {
-        Clay_LayoutElementHashMapItem *hashEntry = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, elementIndex);
-        if (hashEntry->elementId.id == id) {
-            return hashEntry;
-        }
-        elementIndex = hashEntry->nextIndex;
-    }
-    return &Clay_LayoutElementHashMapItem_DEFAULT;
-}
-
-void Clay__UpdateAspectRatioBox(Clay_LayoutElement *layoutElement) {
-    if (layoutElement->config.aspectRatio.aspectRatio != 0) {
-        if (layoutElement->dimensions.width == 0 && layoutElement->dimensions.height != 0) {
-            layoutElement->dimensions.width = layoutElement->dimensions.height * layoutElement->config.aspectRatio.aspectRatio;
-        } else if (layoutElement->dimensions.width != 0 && layoutElement->dimensions.height == 0) {
-            layoutElement->dimensions.height = layoutElement->dimensions.width * (1 / layoutElement->config.aspectRatio.aspectRatio);
-        }
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+    if (item->measuredWordsCount == 0) {
+        item->measuredWordsStartIndex = context->measuredWords.length;
+        context->measuredWordRunOwners.internalArray[context->measuredWords.length] = itemIndex;
     }
+    Clay__MeasuredWordArray_Add(&context->measuredWords, word);
+    item->measuredWordsCount++;
 }
 
-void Clay__CloseElement(void) {
+// Measures every request gathered by Clay__AddTextMeasurementRequest(), and stores the results in the words and text cache items they were made for
+void Clay__FlushTextMeasurementRequests(void) {
     Clay_Context* context = Clay_GetCurrentContext();
-    if (context->booleanWarnings.maxElementsExceeded) {
+    Clay__TextMeasurementRequestArray *requests = &context->textMeasurementRequests;
+    Clay_Dimensions *results = context->textMeasurementResults.internalArray;
+    if (requests->length == 0) {
         return;
     }
-    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    Clay_LayoutConfig *layoutConfig = &openLayoutElement->config.layout;
-    bool elementHasClipHorizontal = openLayoutElement->config.clip.horizontal;
-    bool elementHasClipVertical = openLayoutElement->config.clip.vertical;
-    if (elementHasClipHorizontal || elementHasClipVertical || openLayoutElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE) {
-        context->openClipElementStack.length--;
+    if (context->measureTextBatchFunction) {
+        for (int32_t i = 0; i < requests->length; ++i) {
+            results[i] = CLAY__INIT(Clay_Dimensions) CLAY__DEFAULT_STRUCT;
+        }
+        context->measureTextBatchFunction(requests->internalArray, results, requests->length, context->measureTextBatchUserData);
+    } else {
+        for (int32_t i = 0; i < requests->length; ++i) {
+            results[i] = Clay__MeasureText(requests->internalArray[i].text, requests->internalArray[i].config, context->measureTextUserData);
+        }
+    }
+    for (int32_t i = 0; i < requests->length; ++i) {
+        Clay__TextMeasurementTarget target = context->textMeasurementTargets.internalArray[i];
+        Clay__MeasureTextCacheItem *measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, target.cacheItemIndex);
+        if (target.wordIndex == -1) {
+            measured->spaceWidth = results[i].width;
+        } else {
+            Clay__MeasuredWordArray_Get(&context->measuredWords, target.wordIndex)->width = results[i].width;
+            measured->minWidth = CLAY__MAX(results[i].width, measured->minWidth);
+            measured->unwrappedDimensions.height = CLAY__MAX(measured->unwrappedDimensions.height, results[i].height);
+        }
+    }
+    requests->length = 0;
+    context->textMeasurementTargets.length = 0;
+}
+
+void Clay__AddTextMeasurementRequest(Clay_TextMeasurementRequest request, Clay__TextMeasurementTarget target) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->textMeasurementRequests.length == context->textMeasurementRequests.capacity) {
+        Clay__FlushTextMeasurementRequests();
+    }
+    Clay__TextMeasurementRequestArray_Add(&context->textMeasurementRequests, request);
+    Clay__TextMeasurementTargetArray_Add(&context->textMeasurementTargets, target);
+}
+
+// Measures the words that Clay__MeasureTextCached() split the text of each item into, then calculates the dimensions of the whole text.
+// All of the items are measured with a single call to the batch function if one is set.
+void Clay__MeasureTextCacheItems(Clay__PendingTextMeasurement *pendingItems, int32_t pendingCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t i = 0; i < pendingCount; ++i) {
+        Clay__PendingTextMeasurement *pending = &pendingItems[i];
+        Clay__MeasureTextCacheItem *measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, pending->cacheItemIndex);
+        Clay__AddTextMeasurementRequest(CLAY__INIT(Clay_TextMeasurementRequest) { .text = { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, .config = pending->config }, CLAY__INIT(Clay__TextMeasurementTarget) { pending->cacheItemIndex, -1 });
+        for (int32_t wordIndex = measured->measuredWordsStartIndex; wordIndex < measured->measuredWordsStartIndex + measured->measuredWordsCount; ++wordIndex) {
+            Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
+            int32_t length = measuredWord->length;
+            // Words followed by a space include it in their length, but are measured without it
+            if (length > 0 && pending->text.chars[measuredWord->startOffset + length - 1] == ' ') {
+                length--;
+            }
+            if (length > 0) {
+                Clay__AddTextMeasurementRequest(CLAY__INIT(Clay_TextMeasurementRequest) { .text = { .length = length, .chars = &pending->text.chars[measuredWord->startOffset], .baseChars = pending->text.chars }, .config = pending->config }, CLAY__INIT(Clay__TextMeasurementTarget) { pending->cacheItemIndex, wordIndex });
+            }
+        }
+    }
+    Clay__FlushTextMeasurementRequests();
+
+    for (int32_t i = 0; i < pendingCount; ++i) {
+        Clay__PendingTextMeasurement *pending = &pendingItems[i];
+        Clay__MeasureTextCacheItem *measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, pending->cacheItemIndex);
+        float lineWidth = 0;
+        float measuredWidth = 0;
+        for (int32_t wordIndex = measured->measuredWordsStartIndex; wordIndex < measured->measuredWordsStartIndex + measured->measuredWordsCount; ++wordIndex) {
+            Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
+            // Zero length words mark the start of a new line
+            if (measuredWord->length == 0) {
+                measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
+                lineWidth = 0;
+            } else {
+                if (pending->text.chars[measuredWord->startOffset + measuredWord->length - 1] == ' ') {
+                    measuredWord->width += measured->spaceWidth;
+                }
+                lineWidth += measuredWord->width;
+            }
+        }
+        measured->unwrappedDimensions.width = CLAY__MAX(lineWidth, measuredWidth) - pending->config->letterSpacing;
+        measured->measurementPending = false;
+    }
+}
+
+#define CLAY__UPDATE_HIGH_WATER_MARK(usage, length) (usage).highWaterMark = CLAY__MAX((usage).highWaterMark, (length))
+
+// Measures the items that Clay__MeasureTextCached() deferred for the batch function
+void Clay__MeasureDeferredTextCacheItems(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    CLAY__UPDATE_HIGH_WATER_MARK(context->memoryUsage.textMeasurementBatch, context->pendingTextMeasurements.length);
+    Clay__MeasureTextCacheItems(context->pendingTextMeasurements.internalArray, context->pendingTextMeasurements.length);
+    context->pendingTextMeasurements.length = 0;
+}
+
+// Stores a new item in the text measurement cache without linking it into the hash map.
+// Returns the index of the item, or zero if the cache is full.
+int32_t Clay__AddMeasureTextCacheItem(Clay__MeasureTextCacheItem item) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->measureTextHashMapInternalFreeList.length > 0) {
+        int32_t newItemIndex = Clay__int32_tArray_GetValue(&context->measureTextHashMapInternalFreeList, context->measureTextHashMapInternalFreeList.length - 1);
+        context->measureTextHashMapInternalFreeList.length--;
+        Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, newItemIndex, item);
+        return newItemIndex;
+    }
+    if (context->measureTextHashMapInternal.length == context->measureTextHashMapInternal.capacity - 1) {
+        return 0;
+    }
+    Clay__MeasureTextCacheItemArray_Add(&context->measureTextHashMapInternal, item);
+    return context->measureTextHashMapInternal.length - 1;
+}
+
+// Adds a cache item to the freelist and frees its runs of measured words and wrapped lines. The item must not be linked into the hash map.
+void Clay__FreeMeasureTextCacheItem(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+    // Free the later run first, so that both can be removed from the end of the array
+    if (item->wrappedLinesCount > 0 && item->wrappedLinesStartIndex > item->measuredWordsStartIndex) {
+        Clay__FreeMeasuredWordRun(item->wrappedLinesStartIndex, item->wrappedLinesCount);
+        Clay__FreeMeasuredWordRun(item->measuredWordsStartIndex, item->measuredWordsCount);
+    } else {
+        Clay__FreeMeasuredWordRun(item->measuredWordsStartIndex, item->measuredWordsCount);
+        Clay__FreeMeasuredWordRun(item->wrappedLinesStartIndex, item->wrappedLinesCount);
+    }
+    Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, itemIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1 });
+    Clay__int32_tArray_Add(&context->measureTextHashMapInternalFreeList, itemIndex);
+}
+
+// Links a cache item into the start of its hash bucket
+void Clay__LinkMeasureTextCacheItem(int32_t itemIndex, uint32_t hashBucket) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex)->nextIndex = context->measureTextHashMap.internalArray[hashBucket];
+    context->measureTextHashMap.internalArray[hashBucket] = itemIndex;
+}
+
+// Unlinks a cache item from its hash bucket and frees it
+void Clay__RemoveMeasureTextCacheItem(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+    uint32_t hashBucket = item->id % (context->maxMeasureTextCacheWordCount / 32);
+    int32_t previousIndex = 0;
+    int32_t elementIndex = context->measureTextHashMap.internalArray[hashBucket];
+    while (elementIndex != 0 && elementIndex != itemIndex) {
+        previousIndex = elementIndex;
+        elementIndex = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex)->nextIndex;
+    }
+    if (elementIndex == itemIndex) {
+        if (previousIndex == 0) {
+            context->measureTextHashMap.internalArray[hashBucket] = item->nextIndex;
+        } else {
+            Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, previousIndex)->nextIndex = item->nextIndex;
+        }
+    }
+    Clay__FreeMeasureTextCacheItem(itemIndex);
+}
+
+// Evicts an item that wasn't used in the current frame to make space for new text. Items are searched in a circle starting after the
+// last evicted one (a "clock"), and the first item that has gone unused for longer than the retention setting is evicted. If there
+// isn't one, the first item that wasn't used in the current frame is evicted instead. Returns false if every item is in use.
+bool Clay__EvictMeasureTextCacheItem(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t itemCount = context->measureTextHashMapInternal.length;
+    int32_t evictIndex = 0;
+    for (int32_t i = 1; i < itemCount; ++i) {
+        int32_t itemIndex = context->measureTextCacheClockHand + 1 < itemCount ? context->measureTextCacheClockHand + 1 : 1;
+        context->measureTextCacheClockHand = itemIndex;
+        Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+        // Free items have an id of zero
+        if (item->id == 0 || item->generation == context->generation) {
+            continue;
+        }
+        if (evictIndex == 0) {
+            evictIndex = itemIndex;
+        }
+        if (context->generation - item->generation > context->measureTextCacheRetentionGenerations) {
+            evictIndex = itemIndex;
+            break;
+        }
+    }
+    if (evictIndex == 0) {
+        return false;
+    }
+    context->measureTextCacheClockHand = evictIndex;
+    Clay__RemoveMeasureTextCacheItem(evictIndex);
+    context->measureTextCacheStats.evictions++;
+    return true;
+}
+
+// Moves the clock hand over a few items each frame, so that text which is no longer used is eventually evicted even if its hash bucket
+// is never searched again
+void Clay__SweepMeasureTextCache(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t itemCount = context->measureTextHashMapInternal.length;
+    int32_t sweepCount = CLAY__MIN(itemCount - 1, CLAY__MAX(itemCount / 64, 16));
+    for (int32_t i = 0; i < sweepCount; ++i) {
+        int32_t itemIndex = context->measureTextCacheClockHand + 1 < itemCount ? context->measureTextCacheClockHand + 1 : 1;
+        context->measureTextCacheClockHand = itemIndex;
+        Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+        if (item->id != 0 && context->generation - item->generation > context->measureTextCacheRetentionGenerations) {
+            Clay__RemoveMeasureTextCacheItem(itemIndex);
+            context->measureTextCacheStats.evictions++;
+        }
+    }
+}
+
+// Makes sure that wordCount more words can be added to the end of the measured words array, compacting it if needed.
+// If evict is set, items that weren't used in the current frame are evicted to stay within the memory budget and capacity, and
+// cached wrapped lines are thrown away if there still isn't enough space, as they're only a shortcut.
+bool Clay__ReserveMeasuredWords(int32_t wordCount, bool evict) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t capacity = context->measuredWords.capacity - 1;
+    int32_t budget = capacity;
+    if (context->measureTextCacheMemoryBudget > 0) {
+        budget = CLAY__MIN(capacity, (int32_t)(context->measureTextCacheMemoryBudget / sizeof(Clay__MeasuredWord)));
+    }
+    if (evict) {
+        while (context->measuredWords.length - context->measuredWordsFreeCount + wordCount > budget && Clay__EvictMeasureTextCacheItem()) {}
+    } else if (context->measuredWords.length - context->measuredWordsFreeCount + wordCount > budget) {
+        return false;
+    }
+    if (context->measuredWords.length + wordCount <= capacity) {
+        return true;
+    }
+    if (context->measuredWordsFreeCount > 0) {
+        Clay__CompactMeasuredWords();
+    }
+    if (evict && context->measuredWords.length + wordCount > capacity) {
+        for (int32_t i = 1; i < context->measureTextHashMapInternal.length; ++i) {
+            Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, i);
+            Clay__FreeMeasuredWordRun(item->wrappedLinesStartIndex, item->wrappedLinesCount);
+            item->wrappedLinesCount = 0;
+        }
+        Clay__CompactMeasuredWords();
+    }
+    return context->measuredWords.length + wordCount <= capacity;
+}
+
+// Finds the item for text that isn't statically allocated, by the id and full hash of its contents
+Clay__MeasureTextCacheItem *Clay__FindMeasureTextCacheItem(uint32_t id, int32_t textLength, uint64_t contentsHash) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t elementIndex = context->measureTextHashMap.internalArray[id % (context->maxMeasureTextCacheWordCount / 32)];
+    while (elementIndex != 0) {
+        Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex);
+        if (hashEntry->id == id && !hashEntry->keyedByAddress && hashEntry->textLength == textLength && hashEntry->contentsHash == contentsHash) {
+            return hashEntry;
+        }
+        elementIndex = hashEntry->nextIndex;
+    }
+    return NULL;
+}
+
+static inline int32_t Clay__CountTrailingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int32_t count = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Returns the index of the first space or newline in chars at or after offset, or length if there isn't one
+int32_t Clay__FindWordBoundary(const char *chars, int32_t offset, int32_t length);
+#if !defined(CLAY_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64))
+    int32_t Clay__FindWordBoundary(const char *chars, int32_t offset, int32_t length) {
+        __m128i spaces = _mm_set1_epi8(' ');
+        __m128i newlines = _mm_set1_epi8('\n');
+        while (length - offset >= 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(chars + offset));
+            // One bit for each of the 16 bytes that is a space or newline
+            int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, spaces), _mm_cmpeq_epi8(v, newlines)));
+            if (mask != 0) {
+                return offset + Clay__CountTrailingZeros((uint64_t)mask);
+            }
+            offset += 16;
+        }
+
+        // Handle remaining bytes
+        while (offset < length && chars[offset] != ' ' && chars[offset] != '\n') {
+            offset++;
+        }
+        return offset;
+    }
+#elif !defined(CLAY_DISABLE_SIMD) && defined(__aarch64__)
+    int32_t Clay__FindWordBoundary(const char *chars, int32_t offset, int32_t length) {
+        uint8x16_t spaces = vdupq_n_u8(' ');
+        uint8x16_t newlines = vdupq_n_u8('\n');
+        while (length - offset >= 16) {
+            uint8x16_t v = vld1q_u8((const uint8_t *)(chars + offset));
+            uint8x16_t matches = vorrq_u8(vceqq_u8(v, spaces), vceqq_u8(v, newlines));
+            // Narrow the comparison result to four bits for each of the 16 bytes, as NEON has no movemask
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+            if (mask != 0) {
+                return offset + Clay__CountTrailingZeros(mask) / 4;
+            }
+            offset += 16;
+        }
+
+        // Handle remaining bytes
+        while (offset < length && chars[offset] != ' ' && chars[offset] != '\n') {
+            offset++;
+        }
+        return offset;
+    }
+#else
+    int32_t Clay__FindWordBoundary(const char *chars, int32_t offset, int32_t length) {
+        while (offset < length && chars[offset] != ' ' && chars[offset] != '\n') {
+            offset++;
+        }
+        return offset;
+    }
+#endif
+
+Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, uint64_t contentsHash, Clay_TextElementConfig *config) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    #ifndef CLAY_WASM
+    if (!Clay__MeasureText && !context->measureTextBatchFunction) {
+        if (!context->booleanWarnings.textMeasurementFunctionNotSet) {
+            context->booleanWarnings.textMeasurementFunctionNotSet = true;
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_FUNCTION_NOT_PROVIDED,
+                    .errorText = CLAY_STRING("Clay's internal MeasureText function is null. You may have forgotten to call Clay_SetMeasureTextFunction(), or passed a NULL function pointer by mistake."),
+                    .userData = context->errorHandler.userData });
+        }
+        return &Clay__MeasureTextCacheItem_DEFAULT;
+    }
+    #endif
+    if (!text->isStaticallyAllocated && contentsHash == 0) {
+        contentsHash = Clay__HashData((const uint8_t *)text->chars, text->length);
+    }
+    uint32_t id = Clay__HashStringContentsWithConfig(text, contentsHash, config);
+    uint32_t hashBucket = id % (context->maxMeasureTextCacheWordCount / 32);
+    int32_t elementIndexPrevious = 0;
+    int32_t elementIndex = context->measureTextHashMap.internalArray[hashBucket];
+    while (elementIndex != 0) {
+        Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex);
+        // Statically allocated text is identified by its address, so only the length of its contents is checked
+        bool matches = hashEntry->id == id && hashEntry->keyedByAddress == text->isStaticallyAllocated && hashEntry->textLength == text->length
+            && (text->isStaticallyAllocated || hashEntry->contentsHash == contentsHash);
+        if (matches) {
+            hashEntry->generation = context->generation;
+            context->measureTextCacheStats.hits++;
+            return hashEntry;
+        }
+        // This element hasn't been seen in a few frames, delete the hash map item
+        if (context->generation - hashEntry->generation > context->measureTextCacheRetentionGenerations) {
+            int32_t nextIndex = hashEntry->nextIndex;
+            Clay__FreeMeasureTextCacheItem(elementIndex);
+            context->measureTextCacheStats.evictions++;
+            if (elementIndexPrevious == 0) {
+                context->measureTextHashMap.internalArray[hashBucket] = nextIndex;
+            } else {
+                Clay__MeasureTextCacheItem *previousHashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious);
+                previousHashEntry->nextIndex = nextIndex;
+            }
+            elementIndex = nextIndex;
+        } else {
+            elementIndexPrevious = elementIndex;
+            elementIndex = hashEntry->nextIndex;
+        }
+    }
+
+    context->measureTextCacheStats.misses++;
+    Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .keyedByAddress = text->isStaticallyAllocated, .textLength = text->length, .contentsHash = contentsHash, .id = id, .contentId = id, .generation = context->generation };
+    int32_t newItemIndex = Clay__AddMeasureTextCacheItem(newCacheItem);
+    if (newItemIndex == 0 && Clay__EvictMeasureTextCacheItem()) {
+        newItemIndex = Clay__AddMeasureTextCacheItem(newCacheItem);
+    }
+    if (newItemIndex == 0) {
+        if (!context->booleanWarnings.maxTextMeasureCacheExceeded && Clay__CapacityExceeded()) {
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                    .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+                    .errorText = CLAY_STRING("Clay ran out of capacity while attempting to measure text elements. Try using Clay_SetMaxElementCount() with a higher value."),
+                    .userData = context->errorHandler.userData });
+        }
+        context->booleanWarnings.maxTextMeasureCacheExceeded = true;
+        return &Clay__MeasureTextCacheItem_DEFAULT;
+    }
+    Clay__MeasureTextCacheItem *measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, newItemIndex);
+
+    // Statically allocated text is cached by its address, but text with the same contents may already have been
+    // measured, or imported with Clay_ImportMeasureTextCache()
+    if (text->isStaticallyAllocated) {
+        Clay_String contents = *text;
+        contents.isStaticallyAllocated = false;
+        measured->contentsHash = Clay__HashData((const uint8_t *)text->chars, text->length);
+        measured->contentId = Clay__HashStringContentsWithConfig(&contents, measured->contentsHash, config);
+        Clay__MeasureTextCacheItem *source = Clay__FindMeasureTextCacheItem(measured->contentId, text->length, measured->contentsHash);
+        if (source && !source->measurementPending) {
+            // Mark the source as used so that it can't be evicted while making space for the copy
+            source->generation = context->generation;
+            if (!Clay__ReserveMeasuredWords(source->measuredWordsCount, true)) {
+                context->booleanWarnings.measuredWordsCapacityExceeded = true;
+                Clay__FreeMeasureTextCacheItem(newItemIndex);
+                return &Clay__MeasureTextCacheItem_DEFAULT;
+            }
+            // Reserving may have compacted the array and moved the words of the source item
+            for (int32_t i = 0; i < source->measuredWordsCount; ++i) {
+                Clay__AddMeasuredWord(newItemIndex, *Clay__MeasuredWordArray_Get(&context->measuredWords, source->measuredWordsStartIndex + i));
+            }
+            measured->unwrappedDimensions = source->unwrappedDimensions;
+            measured->minWidth = source->minWidth;
+            measured->spaceWidth = source->spaceWidth;
+            measured->containsNewlines = source->containsNewlines;
+            Clay__LinkMeasureTextCacheItem(newItemIndex, hashBucket);
+            return measured;
+        }
+    }
+
+    // Split the text into words, which are measured by Clay__MeasureTextCacheItems()
+    int32_t start = 0;
+    int32_t end = 0;
+    while (end < text->length) {
+        // A newline adds up to two words, and one more is needed for the end of the text
+        if (!Clay__ReserveMeasuredWords(3, true)) {
+            if (!context->booleanWarnings.measuredWordsCapacityExceeded && Clay__CapacityExceeded()) {
+                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
+                    .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
+                    .userData = context->errorHandler.userData });
+            }
+            context->booleanWarnings.measuredWordsCapacityExceeded = true;
+            Clay__FreeMeasureTextCacheItem(newItemIndex);
+            return &Clay__MeasureTextCacheItem_DEFAULT;
+        }
+        end = Clay__FindWordBoundary(text->chars, end, text->length);
+        if (end == text->length) {
+            break;
+        }
+        char current = text->chars[end];
+        if (current == ' ') {
+            Clay__AddMeasuredWord(newItemIndex, CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start + 1 });
+            start = end + 1;
+        } else if (current == '\n') {
+            if (end - start > 0) {
+                Clay__AddMeasuredWord(newItemIndex, CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start });
+            }
+            Clay__AddMeasuredWord(newItemIndex, CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0 });
+            measured->containsNewlines = true;
+            start = end + 1;
+        }
+        end++;
+    }
+    if (end - start > 0) {
+        Clay__AddMeasuredWord(newItemIndex, CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start });
+    }
+
+    Clay__LinkMeasureTextCacheItem(newItemIndex, hashBucket);
+
+    Clay__PendingTextMeasurement pending = { .text = *text, .config = config, .cacheItemIndex = newItemIndex };
+    if (context->measureTextBatchFunction && context->textMeasurementDeferred) {
+        // Text elements waiting on items that are measured early still pick up their dimensions in Clay__MeasurePendingText()
+        if (context->pendingTextMeasurements.length == context->pendingTextMeasurements.capacity) {
+            Clay__MeasureDeferredTextCacheItems();
+        }
+        measured->measurementPending = true;
+        Clay__PendingTextMeasurementArray_Add(&context->pendingTextMeasurements, pending);
+    } else {
+        Clay__MeasureTextCacheItems(&pending, 1);
+    }
+    return measured;
+}
+
+// Sets the dimensions of a text element from its measurements
+void Clay__SetTextElementDimensions(Clay_LayoutElement *textElement, Clay__LayoutElementData *textData, Clay__MeasureTextCacheItem *textMeasured) {
+    Clay_TextElementConfig *textConfig = &textData->textConfig;
+    Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textMeasured->unwrappedDimensions.height };
+    textElement->dimensions = textDimensions;
+    textElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->minWidth, .height = textDimensions.height };
+    textData->textElementData.preferredDimensions = textMeasured->unwrappedDimensions;
+}
+
+bool Clay__PointIsInsideRect(Clay_Vector2 point, Clay_BoundingBox rect) {
+    return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
+}
+
+Clay__LayoutElementHashMapItemCold *Clay__GetHashMapItemCold(Clay_LayoutElementHashMapItem *hashMapItem) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (hashMapItem == &Clay_LayoutElementHashMapItem_DEFAULT) {
+        return &Clay__LayoutElementHashMapItemCold_DEFAULT;
+    }
+    return Clay__LayoutElementHashMapItemColdArray_Get(&context->layoutElementsHashMapCold, (int32_t)(hashMapItem - context->layoutElementsHashMapInternal.internalArray));
+}
+
+// Returns the index of the slot that holds id, or of the empty slot where it would be inserted
+int32_t Clay__FindHashMapSlot(uint32_t id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t mask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    uint32_t slotIndex = id & mask;
+    while (context->layoutElementsHashMap.internalArray[slotIndex].id != id && context->layoutElementsHashMap.internalArray[slotIndex].id != 0) {
+        slotIndex = (slotIndex + 1) & mask;
+    }
+    return (int32_t)slotIndex;
+}
+
+// Empties the slot that holds id, shifting back later slots in the same probe sequence so that no lookup stops early at the gap
+void Clay__RemoveHashMapSlot(uint32_t id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    uint32_t mask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    uint32_t gapIndex = (uint32_t)Clay__FindHashMapSlot(id);
+    if (slots[gapIndex].id == 0) {
+        return;
+    }
+    uint32_t slotIndex = gapIndex;
+    while (true) {
+        slotIndex = (slotIndex + 1) & mask;
+        if (slots[slotIndex].id == 0) {
+            break;
+        }
+        // The slot can fill the gap if its preferred slot isn't between the gap and its current position
+        uint32_t distanceFromPreferred = (slotIndex - (slots[slotIndex].id & mask)) & mask;
+        uint32_t distanceFromGap = (slotIndex - gapIndex) & mask;
+        if (distanceFromPreferred >= distanceFromGap) {
+            slots[gapIndex] = slots[slotIndex];
+            gapIndex = slotIndex;
+        }
+    }
+    slots[gapIndex] = CLAY__INIT(Clay__LayoutElementHashMapSlot) CLAY__DEFAULT_STRUCT;
+}
+
+Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Clay_LayoutElement* layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (elementId.id == 0) { // Reserved for empty slots
+        return NULL;
+    }
+    int32_t slotIndex = Clay__FindHashMapSlot(elementId.id);
+    Clay__LayoutElementHashMapSlot *slot = &context->layoutElementsHashMap.internalArray[slotIndex];
+    if (slot->id != 0) { // Just replace collision, not a big deal - leave it up to the end user
+        Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, slot->itemIndex);
+        Clay__LayoutElementHashMapItemCold *hashItemCold = Clay__LayoutElementHashMapItemColdArray_Get(&context->layoutElementsHashMapCold, slot->itemIndex);
+        // Collision - resolve based on generation
+        if (hashItem->generation <= context->generation) { // First collision - assume this is the "same" element
+            hashItem->appearedThisFrame = hashItem->generation < context->generation;
+            hashItemCold->elementId = elementId; // Make sure to copy this across. If the stringId reference has changed, we should update the hash item to use the new one.
+            hashItem->generation = context->generation + 1;
+            hashItem->layoutElement = layoutElement;
+            hashItemCold->debugData.collision = false;
+            hashItemCold->onHoverFunction = NULL;
+            hashItemCold->hoverFunctionUserData = 0;
+        } else { // Multiple collisions this frame - two elements have the same ID
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_DUPLICATE_ID,
+                .errorText = CLAY_STRING("An element with this ID was already previously declared during this layout."),
+                .userData = context->errorHandler.userData });
+            if (context->debugModeEnabled) {
+                hashItemCold->debugData.collision = true;
+            }
+        }
+        return hashItem;
+    }
+    if (context->layoutElementsHashMapInternal.length == context->layoutElementsHashMapInternal.capacity - 1 && context->layoutElementsHashMapFreeList.length == 0) {
+        if (!context->booleanWarnings.hashMapCapacityExceeded && Clay__CapacityExceeded()) {
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_HASH_MAP_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay has run out of space in it's internal element ID hashmap.  Try using Clay_SetMaxElementCount() with a higher value."),
+                .userData = context->errorHandler.userData });
+        }
+        context->booleanWarnings.hashMapCapacityExceeded = true;
+        return NULL;
+    }
+
+    int32_t indexToUse = 0;
+    if (context->layoutElementsHashMapFreeList.length > 0) {
+        indexToUse = Clay__int32_tArray_GetValue(&context->layoutElementsHashMapFreeList, context->layoutElementsHashMapFreeList.length - 1);
+        context->layoutElementsHashMapFreeList.length--;
+    } else {
+        indexToUse = context->layoutElementsHashMapInternal.length;
+    }
+    Clay_LayoutElementHashMapItem item = { .layoutElement = layoutElement, .id = elementId.id, .transitionDataIndex = -1, .scrollContainerDataIndex = -1, .generation = context->generation + 1, .appearedThisFrame = true };
+    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Set(&context->layoutElementsHashMapInternal, indexToUse, item);
+    Clay__LayoutElementHashMapItemColdArray_Set(&context->layoutElementsHashMapCold, indexToUse, CLAY__INIT(Clay__LayoutElementHashMapItemCold) { .elementId = elementId });
+    Clay__int32_tArray_Add(&context->layoutElementsHashMapLiveList, indexToUse);
+    *slot = CLAY__INIT(Clay__LayoutElementHashMapSlot) { .id = elementId.id, .itemIndex = indexToUse };
+    return hashItem;
+}
+
+// Layout tasks run on other threads, so they pass in their context rather than relying on Clay_GetCurrentContext()
+Clay_LayoutElementHashMapItem *Clay__GetHashMapItemFromContext(Clay_Context *context, uint32_t id) {
+    if (id == 0) {
+        return &Clay_LayoutElementHashMapItem_DEFAULT;
+    }
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    uint32_t mask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    for (uint32_t slotIndex = id & mask; slots[slotIndex].id != 0; slotIndex = (slotIndex + 1) & mask) {
+        if (slots[slotIndex].id == id) {
+            return &context->layoutElementsHashMapInternal.internalArray[slots[slotIndex].itemIndex];
+        }
+    }
+    return &Clay_LayoutElementHashMapItem_DEFAULT;
+}
+
+Clay_LayoutElementHashMapItem *Clay__GetHashMapItem(uint32_t id) {
+    return Clay__GetHashMapItemFromContext(Clay_GetCurrentContext(), id);
+}
+
+Clay__TransitionDataInternal *Clay__GetTransitionData(Clay_LayoutElementHashMapItem *hashMapItem) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t index = hashMapItem->transitionDataIndex;
+    // The index is left behind when transition data is removed, so it may now be out of range or belong to another element
+    if (index < 0 || index >= context->transitionDatas.length) {
+        return CLAY__NULL;
+    }
+    Clay__TransitionDataInternal *transitionData = &context->transitionDatas.internalArray[index];
+    return transitionData->elementId == hashMapItem->id ? transitionData : CLAY__NULL;
+}
+
+Clay__TransitionDataInternal *Clay__AddTransitionData(Clay_LayoutElementHashMapItem *hashMapItem, Clay__TransitionDataInternal transitionData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->transitionDatas.length == context->transitionDatas.capacity) {
+        context->booleanWarnings.transitionCapacityExceeded = true;
+        if (!Clay__CapacityExceeded()) {
+            return &Clay__TransitionDataInternal_DEFAULT;
+        }
+    }
+    Clay__TransitionDataInternal *added = Clay__TransitionDataInternalArray_Add(&context->transitionDatas, transitionData);
+    if (hashMapItem != &Clay_LayoutElementHashMapItem_DEFAULT && added != &Clay__TransitionDataInternal_DEFAULT) {
+        hashMapItem->transitionDataIndex = context->transitionDatas.length - 1;
+    }
+    return added;
+}
+
+void Clay__RemoveTransitionData(int32_t index) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__TransitionDataInternalArray_RemoveSwapback(&context->transitionDatas, index);
+    // The last transition data has been moved into the removed slot
+    if (index < context->transitionDatas.length) {
+        Clay_LayoutElementHashMapItem *movedHashMapItem = Clay__GetHashMapItem(context->transitionDatas.internalArray[index].elementId);
+        if (movedHashMapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+            movedHashMapItem->transitionDataIndex = index;
+        }
+    }
+}
+
+Clay__ScrollContainerDataInternal *Clay__GetScrollContainerData(Clay_LayoutElementHashMapItem *hashMapItem) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t index = hashMapItem->scrollContainerDataIndex;
+    // As with transition data, a stale index may be out of range or point at another element's scroll data
+    if (index < 0 || index >= context->scrollContainerDatas.length) {
+        return CLAY__NULL;
+    }
+    Clay__ScrollContainerDataInternal *scrollData = &context->scrollContainerDatas.internalArray[index];
+    return scrollData->elementId == hashMapItem->id ? scrollData : CLAY__NULL;
+}
+
+// Scroll data outlives the element's hash map item when Clay_UpdateScrollContainers() isn't called while the element is hidden,
+// so lookups that may create scroll data fall back to a linear search and relink the recreated item.
+Clay__ScrollContainerDataInternal *Clay__FindScrollContainerData(uint32_t id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(id);
+    Clay__ScrollContainerDataInternal *scrollData = Clay__GetScrollContainerData(hashMapItem);
+    if (scrollData) {
+        return scrollData;
+    }
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
+        scrollData = &context->scrollContainerDatas.internalArray[i];
+        if (scrollData->elementId == id) {
+            if (hashMapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+                hashMapItem->scrollContainerDataIndex = i;
+            }
+            return scrollData;
+        }
+    }
+    return CLAY__NULL;
+}
+
+Clay__ScrollContainerDataInternal *Clay__AddScrollContainerData(Clay_LayoutElementHashMapItem *hashMapItem, Clay__ScrollContainerDataInternal scrollData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->scrollContainerDatas.length == context->scrollContainerDatas.capacity) {
+        if (!context->booleanWarnings.scrollContainerCapacityExceeded && Clay__CapacityExceeded()) {
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_SCROLL_CONTAINER_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay ran out of capacity while attempting to track a scroll container. Try using Clay_SetMaxScrollContainerCount() with a higher value."),
+                .userData = context->errorHandler.userData });
+        }
+        context->booleanWarnings.scrollContainerCapacityExceeded = true;
+        return CLAY__NULL;
+    }
+    Clay__ScrollContainerDataInternal *added = Clay__ScrollContainerDataInternalArray_Add(&context->scrollContainerDatas, scrollData);
+    if (hashMapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+        hashMapItem->scrollContainerDataIndex = context->scrollContainerDatas.length - 1;
+    }
+    return added;
+}
+
+void Clay__RemoveScrollContainerData(int32_t index) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, index);
+    // The last scroll data has been moved into the removed slot
+    if (index < context->scrollContainerDatas.length) {
+        Clay_LayoutElementHashMapItem *movedHashMapItem = Clay__GetHashMapItem(context->scrollContainerDatas.internalArray[index].elementId);
+        if (movedHashMapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+            movedHashMapItem->scrollContainerDataIndex = index;
+        }
     }
+}
+
+void Clay__UpdateAspectRatioBox(Clay_LayoutElement *layoutElement) {
+    if (layoutElement->aspectRatio.aspectRatio != 0) {
+        if (layoutElement->dimensions.width == 0 && layoutElement->dimensions.height != 0) {
+            layoutElement->dimensions.width = layoutElement->dimensions.height * layoutElement->aspectRatio.aspectRatio;
+        } else if (layoutElement->dimensions.width != 0 && layoutElement->dimensions.height == 0) {
+            layoutElement->dimensions.height = layoutElement->dimensions.width * (1 / layoutElement->aspectRatio.aspectRatio);
+        }
+    }
+}
 
+// Sizes an element to fit its children, padding and child gaps, clamped to the min and max sizes from its layout config
+void Clay__SizeElementToChildren(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutConfig *layoutConfig = &layoutElement->layout;
+    Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(Clay__GetLayoutElementData(layoutElement));
+    bool elementHasClipHorizontal = clipConfig->horizontal;
+    bool elementHasClipVertical = clipConfig->vertical;
     float leftRightPadding = (float)(layoutConfig->padding.left + layoutConfig->padding.right);
     float topBottomPadding = (float)(layoutConfig->padding.top + layoutConfig->padding.bottom);
+    // Exiting elements are attached to their parent after it has been sized, and don't count towards its size
+    int32_t childCount = 0;
 
-    // Attach children to the current open element
-    openLayoutElement->children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-        openLayoutElement->dimensions.width = leftRightPadding;
-        openLayoutElement->minDimensions.width = leftRightPadding;
-        for (int32_t i = 0; i < openLayoutElement->children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
-            openLayoutElement->dimensions.width += child->dimensions.width;
-            openLayoutElement->dimensions.height = CLAY__MAX(openLayoutElement->dimensions.height, child->dimensions.height + topBottomPadding);
+        layoutElement->dimensions = CLAY__INIT(Clay_Dimensions) { leftRightPadding, 0 };
+        layoutElement->minDimensions = CLAY__INIT(Clay_Dimensions) { leftRightPadding, 0 };
+        for (int32_t i = 0; i < layoutElement->children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->children.elements[i]);
+            if (child->exiting) {
+                continue;
+            }
+            childCount++;
+            layoutElement->dimensions.width += child->dimensions.width;
+            layoutElement->dimensions.height = CLAY__MAX(layoutElement->dimensions.height, child->dimensions.height + topBottomPadding);
             // Minimum size of child elements doesn't matter to clip containers as they can shrink and hide their contents
             if (!elementHasClipHorizontal) {
-                openLayoutElement->minDimensions.width += child->minDimensions.width;
+                layoutElement->minDimensions.width += child->minDimensions.width;
             }
             if (!elementHasClipVertical) {
-                openLayoutElement->minDimensions.height = CLAY__MAX(openLayoutElement->minDimensions.height, child->minDimensions.height + topBottomPadding);
+                layoutElement->minDimensions.height = CLAY__MAX(layoutElement->minDimensions.height, child->minDimensions.height + topBottomPadding);
             }
-            Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.width += childGap;
+        float childGap = (float)(CLAY__MAX(childCount - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.width += childGap;
         if (!elementHasClipHorizontal) {
-            openLayoutElement->minDimensions.width += childGap;
+            layoutElement->minDimensions.width += childGap;
         }
     }
     else if (layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM) {
-        openLayoutElement->dimensions.height = topBottomPadding;
-        openLayoutElement->minDimensions.height = topBottomPadding;
-        for (int32_t i = 0; i < openLayoutElement->children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
-            openLayoutElement->dimensions.height += child->dimensions.height;
-            openLayoutElement->dimensions.width = CLAY__MAX(openLayoutElement->dimensions.width, child->dimensions.width + leftRightPadding);
+        layoutElement->dimensions = CLAY__INIT(Clay_Dimensions) { 0, topBottomPadding };
+        layoutElement->minDimensions = CLAY__INIT(Clay_Dimensions) { 0, topBottomPadding };
+        for (int32_t i = 0; i < layoutElement->children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->children.elements[i]);
+            if (child->exiting) {
+                continue;
+            }
+            childCount++;
+            layoutElement->dimensions.height += child->dimensions.height;
+            layoutElement->dimensions.width = CLAY__MAX(layoutElement->dimensions.width, child->dimensions.width + leftRightPadding);
             // Minimum size of child elements doesn't matter to clip containers as they can shrink and hide their contents
             if (!elementHasClipVertical) {
-                openLayoutElement->minDimensions.height += child->minDimensions.height;
+                layoutElement->minDimensions.height += child->minDimensions.height;
             }
             if (!elementHasClipHorizontal) {
-                openLayoutElement->minDimensions.width = CLAY__MAX(openLayoutElement->minDimensions.width, child->minDimensions.width + leftRightPadding);
+                layoutElement->minDimensions.width = CLAY__MAX(layoutElement->minDimensions.width, child->minDimensions.width + leftRightPadding);
             }
-            Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.height += childGap;
+        float childGap = (float)(CLAY__MAX(childCount - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.height += childGap;
         if (!elementHasClipVertical) {
-            openLayoutElement->minDimensions.height += childGap;
+            layoutElement->minDimensions.height += childGap;
         }
     }
 
-    context->layoutElementChildrenBuffer.length -= openLayoutElement->children.length;
-
     // Clamp element min and max width to the values configured in the layout
     if (layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
         if (layoutConfig->sizing.width.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.width.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
-        openLayoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.width = 0;
+        layoutElement->dimensions.width = 0;
     }
 
     // Clamp element min and max height to the values configured in the layout
@@ -1947,15 +3292,59 @@ void Clay__CloseElement(void) {
         if (layoutConfig->sizing.height.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.height.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
-        openLayoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.height = 0;
+        layoutElement->dimensions.height = 0;
+    }
+
+    Clay__UpdateAspectRatioBox(layoutElement);
+}
+
+void Clay__CloseElement(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    Clay__LayoutElementData *elementData = Clay__GetLayoutElementData(openLayoutElement);
+    Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(elementData);
+    bool elementIsFloating = Clay__GetFloatingConfig(elementData)->attachTo != CLAY_ATTACH_TO_NONE;
+    if (context->frameReuseEnabled) {
+        Clay__AddToDeclarationHash(0); // Distinguishes siblings from children
+    }
+    bool elementHasClipHorizontal = clipConfig->horizontal;
+    bool elementHasClipVertical = clipConfig->vertical;
+    if (elementHasClipHorizontal || elementHasClipVertical || elementIsFloating) {
+        context->openClipElementStack.length--;
+    }
+
+    // Attach children to the current open element
+    openLayoutElement->children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
+    for (int32_t i = 0; i < openLayoutElement->children.length; i++) {
+        Clay__int32_tArray_Add(&context->layoutElementChildren, Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->children.length + i));
     }
+    context->layoutElementChildrenBuffer.length -= openLayoutElement->children.length;
 
-    Clay__UpdateAspectRatioBox(openLayoutElement);
+    // Combine the fingerprints of child elements into this element's fingerprint.
+    // If any child can't be reused, neither can this element.
+    if (context->incrementalLayoutEnabled && openLayoutElement->fingerprint != 0) {
+        uint64_t fingerprint = Clay__MixFingerprint(openLayoutElement->fingerprint, openLayoutElement->id);
+        for (int32_t i = 0; i < openLayoutElement->children.length; i++) {
+            uint64_t childFingerprint = Clay_LayoutElementArray_Get(&context->layoutElements, openLayoutElement->children.elements[i])->fingerprint;
+            if (childFingerprint == 0) {
+                openLayoutElement->fingerprint = 0;
+                break;
+            }
+            fingerprint = Clay__MixFingerprint(fingerprint, childFingerprint);
+        }
+        if (openLayoutElement->fingerprint != 0) {
+            openLayoutElement->fingerprint = fingerprint == 0 ? 1 : fingerprint; // Reserve zero as "not reusable"
+        }
+    }
 
-    bool elementIsFloating = openLayoutElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE;
+    Clay__SizeElementToChildren(openLayoutElement);
+    bool textMeasurementPending = openLayoutElement->textMeasurementPending;
 
     // Close the currently open element
     int32_t closingElementIndex = Clay__int32_tArray_RemoveSwapback(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1);
@@ -1969,6 +3358,7 @@ void Clay__CloseElement(void) {
             return;
         }
         openLayoutElement->children.length++;
+        openLayoutElement->textMeasurementPending |= textMeasurementPending;
         Clay__int32_tArray_Add(&context->layoutElementChildrenBuffer, closingElementIndex);
     }
 }
@@ -2042,16 +3432,21 @@ void Clay__OpenElement(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
         context->booleanWarnings.maxElementsExceeded = true;
+        context->droppedElementCount++;
         return;
     }
     Clay_LayoutElement layoutElement = CLAY__DEFAULT_STRUCT;
     Clay_LayoutElement* openLayoutElement = Clay_LayoutElementArray_Add(&context->layoutElements, layoutElement);
+    Clay__LayoutElementDataArray_Add(&context->layoutElementData, CLAY__INIT(Clay__LayoutElementData) CLAY__DEFAULT_STRUCT);
     Clay__int32_tArray_Add(&context->openLayoutElementStack, context->layoutElements.length - 1);
     // Generate an ID
     Clay_LayoutElement *parentElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2));
     uint32_t offset = parentElement->children.length + parentElement->floatingChildrenCount;
     Clay_ElementId elementId = Clay__HashNumber(offset, parentElement->id);
     openLayoutElement->id = elementId.id;
+    if (context->frameReuseEnabled) {
+        Clay__AddToDeclarationHash(elementId.id);
+    }
     Clay__AddHashMapItem(elementId, openLayoutElement);
     Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
     if (context->openClipElementStack.length > 0) {
@@ -2065,12 +3460,17 @@ void Clay__OpenElementWithId(Clay_ElementId elementId) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
         context->booleanWarnings.maxElementsExceeded = true;
+        context->droppedElementCount++;
         return;
     }
     Clay_LayoutElement layoutElement = CLAY__DEFAULT_STRUCT;
     layoutElement.id = elementId.id;
     Clay_LayoutElement * openLayoutElement = Clay_LayoutElementArray_Add(&context->layoutElements, layoutElement);
+    Clay__LayoutElementDataArray_Add(&context->layoutElementData, CLAY__INIT(Clay__LayoutElementData) CLAY__DEFAULT_STRUCT);
     Clay__int32_tArray_Add(&context->openLayoutElementStack, context->layoutElements.length - 1);
+    if (context->frameReuseEnabled) {
+        Clay__AddToDeclarationHash(elementId.id);
+    }
     Clay__AddHashMapItem(elementId, openLayoutElement);
     Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
     if (context->openClipElementStack.length > 0) {
@@ -2080,16 +3480,19 @@ void Clay__OpenElementWithId(Clay_ElementId elementId) {
     }
 }
 
-void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig textConfig) {
+void Clay__OpenTextElementWithHash(Clay_String text, uint64_t contentsHash, Clay_TextElementConfig textConfig) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
         context->booleanWarnings.maxElementsExceeded = true;
+        context->droppedElementCount++;
         return;
     }
     Clay_LayoutElement *parentElement = Clay__GetOpenLayoutElement();
 
-    Clay_LayoutElement layoutElement = { .textConfig = textConfig, .isTextElement = true };
+    Clay_LayoutElement layoutElement = { .isTextElement = true };
     Clay_LayoutElement *textElement = Clay_LayoutElementArray_Add(&context->layoutElements, layoutElement);
+    Clay__LayoutElementData *textData = Clay__LayoutElementDataArray_Add(&context->layoutElementData, CLAY__INIT(Clay__LayoutElementData) CLAY__DEFAULT_STRUCT);
+    textData->textConfig = textConfig;
     if (context->openClipElementStack.length > 0) {
         Clay__int32_tArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, Clay__int32_tArray_GetValue(&context->openClipElementStack, (int)context->openClipElementStack.length - 1));
     } else {
@@ -2097,22 +3500,85 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig textConfig)
     }
 
     Clay__int32_tArray_Add(&context->layoutElementChildrenBuffer, context->layoutElements.length - 1);
-    Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&text, &textConfig);
+    // Dynamic text is only hashed once per frame, and the hash is reused when the text is looked up again while wrapping
+    if (!text.isStaticallyAllocated && contentsHash == 0) {
+        contentsHash = Clay__HashData((const uint8_t *)text.chars, text.length);
+    }
+    // The config is passed from the element data, so that it outlives this function if the measurement is deferred
+    Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&text, contentsHash, &textData->textConfig);
     Clay_ElementId elementId = Clay__HashNumber(parentElement->children.length + parentElement->floatingChildrenCount, parentElement->id);
     textElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, textElement);
     Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
-    Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig.lineHeight > 0 ? (float)textConfig.lineHeight : textMeasured->unwrappedDimensions.height };
-    textElement->dimensions = textDimensions;
-    textElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->minWidth, .height = textDimensions.height };
-    textElement->textElementData = CLAY__INIT(Clay__TextElementData) { .text = text, .preferredDimensions = textMeasured->unwrappedDimensions };
+    textData->textElementData = CLAY__INIT(Clay__TextElementData) { .text = text, .contentsHash = contentsHash };
+    Clay__SetTextElementDimensions(textElement, textData, textMeasured);
+    if (textMeasured->measurementPending) {
+        // The element and its ancestors are sized again once the text is measured, see Clay__MeasurePendingText()
+        textElement->textMeasurementPending = true;
+        parentElement->textMeasurementPending = true;
+    }
+    if (context->incrementalLayoutEnabled && textMeasured->id != 0) {
+        // Statically allocated text is identified by its address, like in the text measurement cache
+        uint64_t fingerprint = Clay__MixFingerprint(context->layoutFingerprintSeed, text.isStaticallyAllocated ? (uint64_t)(uintptr_t)text.chars : contentsHash);
+        fingerprint = Clay__MixFingerprint(fingerprint, (uint64_t)text.length);
+        fingerprint = Clay__HashTextElementLayout(fingerprint, &textConfig);
+        textElement->fingerprint = fingerprint == 0 ? 1 : fingerprint;
+    }
+    if (context->frameReuseEnabled) {
+        // Render commands reference the text by pointer, so the pointer must match as well as the contents
+        Clay__AddToDeclarationHash((uintptr_t)text.chars);
+        Clay__AddToDeclarationHash((uint64_t)text.length);
+        if (!text.isStaticallyAllocated) {
+            Clay__AddToDeclarationHash(contentsHash);
+        }
+        Clay__AddToDeclarationHash(Clay__HashTextElementConfig(0, &textConfig));
+    }
     parentElement->children.length++;
 }
 
+void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig textConfig) {
+    Clay__OpenTextElementWithHash(text, 0, textConfig);
+}
+
 void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    openLayoutElement->config = *declaration;
+    Clay__LayoutElementData *elementData = Clay__GetLayoutElementData(openLayoutElement);
+    openLayoutElement->layout = declaration->layout;
+    openLayoutElement->aspectRatio = declaration->aspectRatio;
+    elementData->backgroundColor = declaration->backgroundColor;
+    elementData->overlayColor = declaration->overlayColor;
+    elementData->cornerRadius = declaration->cornerRadius;
+    elementData->userData = declaration->userData;
+    // Only configs that differ from their defaults are stored. If a pool is full the config is dropped, so the
+    // code below checks the stored configs rather than the declaration.
+    if (!Clay__MemCmp((const char*)&declaration->floating, (const char*)&Clay_FloatingElementConfig_DEFAULT, sizeof(Clay_FloatingElementConfig))) {
+        Clay_FloatingElementConfig *config = Clay__AddFloatingConfig(elementData);
+        if (config) *config = declaration->floating;
+    }
+    if (!Clay__MemCmp((const char*)&declaration->clip, (const char*)&Clay_ClipElementConfig_DEFAULT, sizeof(Clay_ClipElementConfig))) {
+        Clay_ClipElementConfig *config = Clay__AddClipConfig(elementData);
+        if (config) *config = declaration->clip;
+    }
+    if (!Clay__MemCmp((const char*)&declaration->border, (const char*)&Clay_BorderElementConfig_DEFAULT, sizeof(Clay_BorderElementConfig))) {
+        Clay_BorderElementConfig *config = Clay__AddBorderConfig(elementData);
+        if (config) *config = declaration->border;
+    }
+    if (!Clay__MemCmp((const char*)&declaration->transition, (const char*)&Clay_TransitionElementConfig_DEFAULT, sizeof(Clay_TransitionElementConfig))) {
+        Clay_TransitionElementConfig *config = Clay__AddTransitionConfig(elementData);
+        if (config) *config = declaration->transition;
+    }
+    if (declaration->image.imageData) {
+        Clay_ImageElementConfig *config = Clay__AddImageConfig(elementData);
+        if (config) *config = declaration->image;
+    }
+    if (declaration->custom.customData) {
+        Clay_CustomElementConfig *config = Clay__AddCustomConfig(elementData);
+        if (config) *config = declaration->custom;
+    }
+    Clay_FloatingElementConfig *floatingConfig = Clay__GetFloatingConfig(elementData);
+    Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(elementData);
+    Clay_TransitionElementConfig *transitionConfig = Clay__GetTransitionConfig(elementData);
     if ((declaration->layout.sizing.width.type == CLAY__SIZING_TYPE_PERCENT && declaration->layout.sizing.width.size.percent > 1) || (declaration->layout.sizing.height.type == CLAY__SIZING_TYPE_PERCENT && declaration->layout.sizing.height.size.percent > 1)) {
         context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                 .errorType = CLAY_ERROR_TYPE_PERCENTAGE_OVER_1,
@@ -2120,19 +3586,18 @@ void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
                 .userData = context->errorHandler.userData });
     }
 
-    if (declaration->floating.attachTo != CLAY_ATTACH_TO_NONE) {
-        Clay_FloatingElementConfig* floatingConfig = &openLayoutElement->config.floating;
+    if (floatingConfig->attachTo != CLAY_ATTACH_TO_NONE) {
         // This looks dodgy but because of the auto generated root element the depth of the tree will always be at least 2 here
         Clay_LayoutElement *hierarchicalParent = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2));
         if (hierarchicalParent) {
             uint32_t clipElementId = 0;
-            if (declaration->floating.attachTo == CLAY_ATTACH_TO_PARENT) {
+            if (floatingConfig->attachTo == CLAY_ATTACH_TO_PARENT) {
                 // Attach to the element's direct hierarchical parent
                 floatingConfig->parentId = hierarchicalParent->id;
                 if (context->openClipElementStack.length > 0) {
                     clipElementId = Clay__int32_tArray_GetValue(&context->openClipElementStack, (int)context->openClipElementStack.length - 1);
                 }
-            } else if (declaration->floating.attachTo == CLAY_ATTACH_TO_ELEMENT_WITH_ID) {
+            } else if (floatingConfig->attachTo == CLAY_ATTACH_TO_ELEMENT_WITH_ID) {
                 Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingConfig->parentId);
                 if (parentItem == &Clay_LayoutElementHashMapItem_DEFAULT) {
                     context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
@@ -2142,10 +3607,10 @@ void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
                 } else {
                     clipElementId = Clay__int32_tArray_GetValue(&context->layoutElementClipElementIds, (int32_t)(parentItem->layoutElement - context->layoutElements.internalArray));
                 }
-            } else if (declaration->floating.attachTo == CLAY_ATTACH_TO_ROOT) {
+            } else if (floatingConfig->attachTo == CLAY_ATTACH_TO_ROOT) {
                 floatingConfig->parentId = Clay__HashString(CLAY_STRING("Clay__RootContainer"), 0).id;
             }
-            if (declaration->floating.clipTo == CLAY_CLIP_TO_NONE) {
+            if (floatingConfig->clipTo == CLAY_CLIP_TO_NONE) {
                 clipElementId = 0;
             }
             int32_t currentElementIndex = Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1);
@@ -2160,120 +3625,648 @@ void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
         }
     }
 
-    if (declaration->clip.horizontal || declaration->clip.vertical) {
+    if (clipConfig->horizontal || clipConfig->vertical) {
         Clay__int32_tArray_Add(&context->openClipElementStack, (int)openLayoutElement->id);
         // Retrieve or create cached data to track scroll position across frames
-        Clay__ScrollContainerDataInternal *scrollOffset = CLAY__NULL;
-        for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-            Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-            if (openLayoutElement->id == mapping->elementId) {
-                scrollOffset = mapping;
-                scrollOffset->layoutElement = openLayoutElement;
-                scrollOffset->openThisFrame = true;
-            }
-        }
-        if (!scrollOffset) {
-            scrollOffset = Clay__ScrollContainerDataInternalArray_Add(&context->scrollContainerDatas, CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = openLayoutElement, .scrollOrigin = {-1,-1}, .elementId = openLayoutElement->id, .openThisFrame = true});
+        Clay__ScrollContainerDataInternal *scrollOffset = Clay__FindScrollContainerData(openLayoutElement->id);
+        if (scrollOffset) {
+            scrollOffset->layoutElement = openLayoutElement;
+            scrollOffset->clipConfig = *clipConfig;
+            scrollOffset->openThisFrame = true;
+        } else {
+            scrollOffset = Clay__AddScrollContainerData(Clay__GetHashMapItem(openLayoutElement->id), CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = openLayoutElement, .clipConfig = *clipConfig, .scrollOrigin = {-1,-1}, .elementId = openLayoutElement->id, .openThisFrame = true});
         }
-        if (context->externalScrollHandlingEnabled) {
+        if (scrollOffset && context->externalScrollHandlingEnabled) {
             scrollOffset->scrollPosition = Clay__QueryScrollOffset(scrollOffset->elementId, context->queryScrollOffsetUserData);
         }
     }
     // Setup data to track transitions across frames
-    if (declaration->transition.handler) {
-        Clay__TransitionDataInternal *transitionData = CLAY__NULL;
+    if (transitionConfig->handler) {
         Clay_LayoutElement* parentElement = Clay__GetParentElement();
-        for (int32_t i = 0; i < context->transitionDatas.length; i++) {
-            Clay__TransitionDataInternal *existingData = Clay__TransitionDataInternalArray_Get(&context->transitionDatas, i);
-            if (openLayoutElement->id == existingData->elementId) {
-                if (existingData->state == CLAY_TRANSITION_STATE_EXITING) {
-                    existingData->state = CLAY_TRANSITION_STATE_IDLE;
-                    Clay_LayoutElementHashMapItem* hashMapItem = Clay__GetHashMapItem(openLayoutElement->id);
-                    hashMapItem->appearedThisFrame = false;
-                }
-                transitionData = existingData;
-                transitionData->elementThisFrame = openLayoutElement;
-                if (transitionData->parentId != parentElement->id) {
-                    transitionData->reparented = true;
-                }
-                transitionData->parentId = parentElement->id;
-                transitionData->siblingIndex = parentElement->children.length;
-                transitionData->transitionOut = !!declaration->transition.exit.setFinalState;
+        Clay_LayoutElementHashMapItem* hashMapItem = Clay__GetHashMapItem(openLayoutElement->id);
+        Clay__TransitionDataInternal *transitionData = Clay__GetTransitionData(hashMapItem);
+        if (transitionData) {
+            if (transitionData->state == CLAY_TRANSITION_STATE_EXITING) {
+                transitionData->state = CLAY_TRANSITION_STATE_IDLE;
+                hashMapItem->appearedThisFrame = false;
             }
-        }
-        if (!transitionData) {
-            transitionData = Clay__TransitionDataInternalArray_Add(&context->transitionDatas, CLAY__INIT(Clay__TransitionDataInternal){
+            transitionData->elementThisFrame = openLayoutElement;
+            if (transitionData->parentId != parentElement->id) {
+                transitionData->reparented = true;
+            }
+            transitionData->parentId = parentElement->id;
+            transitionData->siblingIndex = parentElement->children.length;
+            transitionData->transitionOut = !!transitionConfig->exit.setFinalState;
+        } else {
+            Clay__AddTransitionData(hashMapItem, CLAY__INIT(Clay__TransitionDataInternal){
                 .elementThisFrame = openLayoutElement,
                 .elementId = openLayoutElement->id,
                 .parentId = parentElement->id,
                 .siblingIndex = parentElement->children.length,
-                .transitionOut = !!declaration->transition.exit.setFinalState
+                .transitionOut = !!transitionConfig->exit.setFinalState
             });
         }
     }
+    // Aspect ratio elements rescale their width after both sizing passes, so they and their ancestors are never reused
+    if (context->incrementalLayoutEnabled && declaration->aspectRatio.aspectRatio == 0) {
+        openLayoutElement->fingerprint = Clay__MixFingerprint(Clay__HashElementLayout(declaration), floatingConfig->parentId);
+    }
+    if (context->frameReuseEnabled) {
+        Clay__AddToDeclarationHash(Clay__HashElementDeclaration(declaration));
+    }
+}
+
+void Clay__ConfigureOpenElement(const Clay_ElementDeclaration declaration) {
+    Clay__ConfigureOpenElementPtr(&declaration);
+}
+
+void Clay__InitializeEphemeralMemory(Clay_Context* context) {
+    int32_t maxElementCount = context->maxElementCount;
+    // Ephemeral Memory - reset every frame
+    Clay_Arena *arena = &context->internalArena;
+    arena->nextAllocation = context->arenaResetOffset;
+
+    context->layoutElementChildrenBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElements = Clay_LayoutElementArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementData = Clay__LayoutElementDataArray_Allocate_Arena(maxElementCount, arena);
+    // Slot zero of each config pool is reserved to mean "not set", see Clay__GetFloatingConfig()
+    int32_t maxElementConfigCount = context->maxElementConfigCount > 0 ? context->maxElementConfigCount : CLAY__MAX(maxElementCount / 4, 1);
+    context->floatingConfigs = Clay__FloatingElementConfigArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->floatingConfigs.length = 1;
+    context->clipConfigs = Clay__ClipElementConfigArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->clipConfigs.length = 1;
+    context->borderConfigs = Clay__BorderElementConfigArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->borderConfigs.length = 1;
+    context->transitionConfigs = Clay__TransitionElementConfigArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->transitionConfigs.length = 1;
+    context->imageConfigs = Clay__ImageElementConfigArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->imageConfigs.length = 1;
+    context->customConfigs = Clay__CustomElementConfigArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->customConfigs.length = 1;
+    context->warnings = Clay__WarningArray_Allocate_Arena(context->maxWarningCount > 0 ? context->maxWarningCount : 100, arena);
+
+    context->layoutElementIdStrings = Clay__StringArray_Allocate_Arena(maxElementCount, arena);
+    context->wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(context->maxWrappedTextLineCount > 0 ? context->maxWrappedTextLineCount : maxElementCount, arena);
+    // Nothing in the tree node array is kept while containers are being sized, so sizing also distributes space through its memory,
+    // which needs two floats for each child, see Clay__SizeChildrenAlongAxis()
+    context->layoutElementTreeNodeArray1 = Clay__LayoutElementTreeNodeArray_Allocate_Arena(maxElementCount, arena);
+    // Apart from the root element, every tree root is a floating element, which has a slot in the floating config pool
+    context->layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->layoutElementTreeRootsSortBuffer = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxElementConfigCount + 1, arena);
+    context->layoutElementChildren = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->openLayoutElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->renderCommands = Clay_RenderCommandArray_Allocate_Arena(context->maxRenderCommandCount > 0 ? context->maxRenderCommandCount : maxElementCount, arena);
+    context->treeNodeVisited = Clay__boolArray_Allocate_Arena(maxElementCount, arena);
+    context->treeNodeVisited.length = context->treeNodeVisited.capacity; // This array is accessed directly rather than behaving as a list
+    context->openClipElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    int32_t maxPointerHitGridElementCount = context->maxPointerHitGridElementCount > 0 ? context->maxPointerHitGridElementCount : CLAY__MIN(maxElementCount, 8192);
+    context->pointerHitRecords = Clay__PointerHitRecordArray_Allocate_Arena(maxPointerHitGridElementCount, arena);
+    context->pointerHitGridCellStarts = Clay__int32_tArray_Allocate_Arena(CLAY__POINTER_HIT_GRID_SIZE * CLAY__POINTER_HIT_GRID_SIZE + 1, arena);
+    context->pointerHitGridEntries = Clay__int32_tArray_Allocate_Arena(maxPointerHitGridElementCount * 2, arena);
+    context->dynamicStringData = Clay__charArray_Allocate_Arena(context->maxDynamicStringDataSize > 0 ? context->maxDynamicStringDataSize : maxElementCount, arena);
+    // These only need to hold one batch, as they are measured early when they fill up
+    int32_t maxTextMeasurementBatchSize = context->maxTextMeasurementBatchSize > 0 ? context->maxTextMeasurementBatchSize : 1024;
+    context->pendingTextMeasurements = Clay__PendingTextMeasurementArray_Allocate_Arena(maxTextMeasurementBatchSize, arena);
+    context->textMeasurementRequests = Clay__TextMeasurementRequestArray_Allocate_Arena(maxTextMeasurementBatchSize, arena);
+    context->textMeasurementTargets = Clay__TextMeasurementTargetArray_Allocate_Arena(maxTextMeasurementBatchSize, arena);
+    context->textMeasurementResults = Clay__DimensionsArray_Allocate_Arena(maxTextMeasurementBatchSize, arena);
+}
+
+void Clay__InitializePersistentMemory(Clay_Context* context) {
+    // Persistent memory - initialized once and not reset
+    int32_t maxElementCount = context->maxElementCount;
+    int32_t maxMeasureTextCacheWordCount = context->maxMeasureTextCacheWordCount;
+    Clay_Arena *arena = &context->internalArena;
+
+    int32_t maxScrollContainerCount = context->maxScrollContainerCount > 0 ? context->maxScrollContainerCount : CLAY__MAX(maxElementCount / 32, 100);
+    context->scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(maxScrollContainerCount, arena);
+    context->transitionDatas = Clay__TransitionDataInternalArray_Allocate_Arena(context->maxTransitionCount > 0 ? context->maxTransitionCount : 200, arena);
+    context->layoutElementsHashMapInternal = Clay__LayoutElementHashMapItemArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementsHashMapCold = Clay__LayoutElementHashMapItemColdArray_Allocate_Arena(maxElementCount, arena);
+    // Linear probing needs the table to stay at most half full, and a power of two size lets the slot be found with a mask.
+    // Slots are 8 bytes, so this is 16 to 32 bytes per element, about 2% of Clay_MinMemorySize() at the default element count.
+    // Allowing the table to fill to 75% made failed lookups up to 3x slower in benchmarks/element_lookup.c.
+    int32_t hashMapSlotCount = 1;
+    while (hashMapSlotCount < maxElementCount * 2) {
+        hashMapSlotCount *= 2;
+    }
+    context->layoutElementsHashMap = Clay__LayoutElementHashMapSlotArray_Allocate_Arena(hashMapSlotCount, arena);
+    context->layoutElementsHashMapFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementsHashMapLiveList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->measureTextHashMapInternal = Clay__MeasureTextCacheItemArray_Allocate_Arena(maxElementCount, arena);
+    context->measureTextHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->measuredWordRunOwners = Clay__int32_tArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
+    // There is one hash bucket for every 32 words of the cache, see Clay__MeasureTextCached()
+    context->measureTextHashMap = Clay__int32_tArray_Allocate_Arena(CLAY__MAX(maxElementCount, maxMeasureTextCacheWordCount / 32), arena);
+    context->measuredWords = Clay__MeasuredWordArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
+    context->pointerOverIds = Clay_ElementIdArray_Allocate_Arena(context->maxPointerOverIdCount > 0 ? context->maxPointerOverIdCount : maxElementCount, arena);
+    context->arenaResetOffset = arena->nextAllocation;
+}
+
+#define CLAY__COPY_ARRAY_ITEMS(destination, source, count) \
+    for (int32_t copyIndex = 0; copyIndex < (count); ++copyIndex) { (destination).internalArray[copyIndex] = (source).internalArray[copyIndex]; }
+
+// Moves the persistent and ephemeral memory of the context into a new block from the block allocator, see Clay_SetArenaBlockAllocator().
+// Capacities that ran out during the previous frame are doubled, and the persistent data is copied across so that element IDs, scroll
+// positions, transitions and the text measurement cache all survive. Called at the start of Clay_BeginLayout(), while nothing in the
+// previous block is in use apart from the pointers to elements that are fixed up below.
+void Clay__GrowArena(Clay_Context *context) {
+    Clay_BooleanWarnings warnings = context->booleanWarnings;
+    // Other capacities running out also cut the frame short, see Clay__CapacityExceeded(), so the element count is checked directly
+    int32_t requiredElementCount = context->layoutElements.length + context->droppedElementCount + 1;
+    bool growElements = requiredElementCount > context->layoutElements.capacity || warnings.hashMapCapacityExceeded || warnings.maxTextMeasureCacheExceeded || warnings.childrenCapacityExceeded
+        // Capacities that haven't been set follow the element count
+        || (warnings.maxRenderCommandsExceeded && context->maxRenderCommandCount == 0)
+        || (warnings.wrappedTextLinesCapacityExceeded && context->maxWrappedTextLineCount == 0)
+        || (warnings.pointerOverIdsCapacityExceeded && context->maxPointerOverIdCount == 0)
+        || (warnings.dynamicStringDataCapacityExceeded && context->maxDynamicStringDataSize == 0);
+    if (!context->arenaGrowthRequested && !warnings.maxElementsExceeded && !growElements && !warnings.elementConfigCapacityExceeded && !warnings.measuredWordsCapacityExceeded
+        && !warnings.scrollContainerCapacityExceeded && !warnings.transitionCapacityExceeded && !warnings.warningCapacityExceeded && !warnings.maxRenderCommandsExceeded
+        && !warnings.wrappedTextLinesCapacityExceeded && !warnings.pointerOverIdsCapacityExceeded && !warnings.dynamicStringDataCapacityExceeded
+        && !warnings.pointerHitGridCapacityExceeded) {
+        return;
+    }
+    context->arenaGrowthRequested = false;
+    Clay_Context previous = *context;
+    if (growElements) {
+        // Grow enough to fit all of the elements declared last frame, including the ones that were dropped
+        do {
+            context->maxElementCount *= 2;
+        } while (context->maxElementCount < requiredElementCount);
+    }
+    if (warnings.elementConfigCapacityExceeded) {
+        context->maxElementConfigCount = (previous.floatingConfigs.capacity - 1) * 2;
+    }
+    if (warnings.measuredWordsCapacityExceeded) {
+        context->maxMeasureTextCacheWordCount *= 2;
+    }
+    if (warnings.scrollContainerCapacityExceeded) {
+        context->maxScrollContainerCount = previous.scrollContainerDatas.capacity * 2;
+    }
+    if (warnings.transitionCapacityExceeded) {
+        context->maxTransitionCount = previous.transitionDatas.capacity * 2;
+    }
+    if (warnings.warningCapacityExceeded) {
+        context->maxWarningCount = previous.warnings.capacity * 2;
+    }
+    if (warnings.maxRenderCommandsExceeded && context->maxRenderCommandCount > 0) {
+        context->maxRenderCommandCount = previous.renderCommands.capacity * 2;
+    }
+    if (warnings.wrappedTextLinesCapacityExceeded && context->maxWrappedTextLineCount > 0) {
+        context->maxWrappedTextLineCount = previous.wrappedTextLines.capacity * 2;
+    }
+    if (warnings.pointerOverIdsCapacityExceeded && context->maxPointerOverIdCount > 0) {
+        context->maxPointerOverIdCount = previous.pointerOverIds.capacity * 2;
+    }
+    if (warnings.dynamicStringDataCapacityExceeded && context->maxDynamicStringDataSize > 0) {
+        context->maxDynamicStringDataSize = previous.dynamicStringData.capacity * 2;
+    }
+    if (warnings.pointerHitGridCapacityExceeded) {
+        context->maxPointerHitGridElementCount = previous.pointerHitRecords.capacity * 2;
+    }
+    // The persistent data is copied to the same indices, so its capacities can't shrink
+    context->maxElementCount = CLAY__MAX(context->maxElementCount, previous.layoutElementsHashMapInternal.capacity);
+    context->maxMeasureTextCacheWordCount = CLAY__MAX(context->maxMeasureTextCacheWordCount, previous.measuredWords.capacity);
+    if (context->maxScrollContainerCount > 0) {
+        context->maxScrollContainerCount = CLAY__MAX(context->maxScrollContainerCount, previous.scrollContainerDatas.capacity);
+    }
+    context->maxTransitionCount = CLAY__MAX(context->maxTransitionCount, previous.transitionDatas.capacity);
+    if (context->maxPointerOverIdCount > 0) {
+        context->maxPointerOverIdCount = CLAY__MAX(context->maxPointerOverIdCount, previous.pointerOverIds.length);
+    }
+
+    // Measure the block by allocating from an arena without any memory, as Clay_MinMemorySize() does
+    context->internalArena = CLAY__INIT(Clay_Arena) { .capacity = SIZE_MAX };
+    Clay__InitializePersistentMemory(context);
+    Clay__InitializeEphemeralMemory(context);
+    size_t blockSize = context->internalArena.nextAllocation + 64;
+    void *block = context->arenaBlockAllocateFunction(blockSize, context->arenaBlockAllocatorUserData);
+    if (!block) {
+        *context = previous;
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay ran out of capacity and attempted to grow its arena, but the function passed to Clay_SetArenaBlockAllocator() returned NULL."),
+            .userData = context->errorHandler.userData });
+        return;
+    }
+    // Cacheline align the block, as Clay_Initialize() does
+    uintptr_t baseOffset = 64 - ((uintptr_t)block % 64);
+    baseOffset = baseOffset == 64 ? 0 : baseOffset;
+    context->internalArena = Clay_CreateArenaWithCapacityAndMemory(blockSize - baseOffset, (char *)block + baseOffset);
+    context->arenaBlock = block;
+    context->arenaBlockSize = blockSize;
+    Clay__InitializePersistentMemory(context);
+
+    CLAY__COPY_ARRAY_ITEMS(context->scrollContainerDatas, previous.scrollContainerDatas, previous.scrollContainerDatas.length);
+    context->scrollContainerDatas.length = previous.scrollContainerDatas.length;
+    CLAY__COPY_ARRAY_ITEMS(context->transitionDatas, previous.transitionDatas, previous.transitionDatas.length);
+    context->transitionDatas.length = previous.transitionDatas.length;
+    CLAY__COPY_ARRAY_ITEMS(context->layoutElementsHashMapInternal, previous.layoutElementsHashMapInternal, previous.layoutElementsHashMapInternal.length);
+    context->layoutElementsHashMapInternal.length = previous.layoutElementsHashMapInternal.length;
+    CLAY__COPY_ARRAY_ITEMS(context->layoutElementsHashMapCold, previous.layoutElementsHashMapCold, previous.layoutElementsHashMapCold.length);
+    context->layoutElementsHashMapCold.length = previous.layoutElementsHashMapCold.length;
+    CLAY__COPY_ARRAY_ITEMS(context->layoutElementsHashMapFreeList, previous.layoutElementsHashMapFreeList, previous.layoutElementsHashMapFreeList.length);
+    context->layoutElementsHashMapFreeList.length = previous.layoutElementsHashMapFreeList.length;
+    CLAY__COPY_ARRAY_ITEMS(context->layoutElementsHashMapLiveList, previous.layoutElementsHashMapLiveList, previous.layoutElementsHashMapLiveList.length);
+    context->layoutElementsHashMapLiveList.length = previous.layoutElementsHashMapLiveList.length;
+    CLAY__COPY_ARRAY_ITEMS(context->measureTextHashMapInternal, previous.measureTextHashMapInternal, previous.measureTextHashMapInternal.length);
+    context->measureTextHashMapInternal.length = previous.measureTextHashMapInternal.length;
+    CLAY__COPY_ARRAY_ITEMS(context->measureTextHashMapInternalFreeList, previous.measureTextHashMapInternalFreeList, previous.measureTextHashMapInternalFreeList.length);
+    context->measureTextHashMapInternalFreeList.length = previous.measureTextHashMapInternalFreeList.length;
+    CLAY__COPY_ARRAY_ITEMS(context->measuredWords, previous.measuredWords, previous.measuredWords.length);
+    context->measuredWords.length = previous.measuredWords.length;
+    // The run owners are indexed by word, and have no length of their own
+    CLAY__COPY_ARRAY_ITEMS(context->measuredWordRunOwners, previous.measuredWordRunOwners, previous.measuredWords.length);
+    CLAY__COPY_ARRAY_ITEMS(context->pointerOverIds, previous.pointerOverIds, previous.pointerOverIds.length);
+    context->pointerOverIds.length = previous.pointerOverIds.length;
+
+    // The hash maps are indexed by a number of slots and buckets that may have changed, so their items are inserted again
+    for (int32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
+        context->layoutElementsHashMap.internalArray[i] = CLAY__INIT(Clay__LayoutElementHashMapSlot) CLAY__DEFAULT_STRUCT;
+    }
+    uint32_t slotMask = (uint32_t)context->layoutElementsHashMap.capacity - 1;
+    for (int32_t i = 0; i < context->layoutElementsHashMapLiveList.length; ++i) {
+        int32_t itemIndex = context->layoutElementsHashMapLiveList.internalArray[i];
+        Clay_LayoutElementHashMapItem *item = &context->layoutElementsHashMapInternal.internalArray[itemIndex];
+        uint32_t slotIndex = item->id & slotMask;
+        while (context->layoutElementsHashMap.internalArray[slotIndex].id != 0) {
+            slotIndex = (slotIndex + 1) & slotMask;
+        }
+        context->layoutElementsHashMap.internalArray[slotIndex] = CLAY__INIT(Clay__LayoutElementHashMapSlot) { .id = item->id, .itemIndex = itemIndex };
+        // The element was in the previous block, and will be pointed at its new copy if it's declared again
+        item->layoutElement = &Clay_LayoutElement_DEFAULT;
+    }
+    for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
+        context->measureTextHashMap.internalArray[i] = 0;
+    }
+    for (int32_t i = 1; i < context->measureTextHashMapInternal.length; ++i) {
+        // Free items have an id of zero
+        uint32_t id = context->measureTextHashMapInternal.internalArray[i].id;
+        if (id != 0) {
+            Clay__LinkMeasureTextCacheItem(i, id % (context->maxMeasureTextCacheWordCount / 32));
+        }
+    }
+    // Clay_BeginLayout() lays the ephemeral arrays out the same way again, so each element declared in the same order keeps its index.
+    // Clay_GetScrollOffset() is called before a scroll container is configured, and finds it by comparing against the element at that index.
+    Clay__InitializeEphemeralMemory(context);
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
+        Clay__ScrollContainerDataInternal *scrollData = &context->scrollContainerDatas.internalArray[i];
+        if (scrollData->layoutElement >= previous.layoutElements.internalArray && scrollData->layoutElement < previous.layoutElements.internalArray + previous.layoutElements.length) {
+            scrollData->layoutElement = context->layoutElements.internalArray + (scrollData->layoutElement - previous.layoutElements.internalArray);
+        } else {
+            scrollData->layoutElement = &Clay_LayoutElement_DEFAULT;
+        }
+    }
+    // Exiting elements are cloned into the previous block between frames, and can't be moved to the new one as their
+    // configs are referenced by index. Pointing them at the default element removes their transition data in Clay_EndLayout().
+    for (int32_t i = 0; i < context->transitionDatas.length; ++i) {
+        context->transitionDatas.internalArray[i].elementThisFrame = &Clay_LayoutElement_DEFAULT;
+    }
+    // The render commands of the previous frame were in the previous block
+    context->previousDeclarationHash = 0;
+
+    if (previous.arenaBlock && context->arenaBlockFreeFunction) {
+        context->arenaBlockFreeFunction(previous.arenaBlock, previous.arenaBlockSize, context->arenaBlockAllocatorUserData);
+    }
+}
+
+const float CLAY__EPSILON = 0.01;
+
+bool Clay__FloatEqual(float left, float right) {
+    float subtracted = left - right;
+    return subtracted < CLAY__EPSILON && subtracted > -CLAY__EPSILON;
+}
+
+Clay_SizingAxis Clay__GetElementSizing(Clay_LayoutElement* element, bool xAxis) {
+    if (element->isTextElement) {
+        return CLAY__INIT(Clay_SizingAxis) {};
+    } else {
+        return xAxis ? element->layout.sizing.width : element->layout.sizing.height;
+    }
+}
+
+bool Clay__LayoutElementIsUnchanged(Clay_Context *context, Clay_LayoutElement *element, bool xAxis) {
+    if (element->fingerprint == 0) {
+        return false;
+    }
+    Clay_LayoutElementHashMapItem *item = Clay__GetHashMapItemFromContext(context, element->id);
+    if (item->layoutFingerprint != element->fingerprint || item->layoutDimensions.width != element->dimensions.width) {
+        return false;
+    }
+    // The height of an element isn't known until after the x axis has been sized and text has been wrapped
+    return xAxis || item->layoutDimensions.height == element->dimensions.height;
+}
+
+void Clay__SiftDownFloat(float *values, int32_t parent, int32_t length) {
+    while (parent * 2 + 1 < length) {
+        int32_t child = parent * 2 + 1;
+        if (child + 1 < length && values[child + 1] > values[child]) {
+            child++;
+        }
+        if (values[child] <= values[parent]) {
+            return;
+        }
+        float swap = values[child];
+        values[child] = values[parent];
+        values[parent] = swap;
+        parent = child;
+    }
+}
+
+// In place heap sort, ascending
+void Clay__SortFloats(float *values, int32_t length) {
+    for (int32_t i = length / 2 - 1; i >= 0; --i) {
+        Clay__SiftDownFloat(values, i, length);
+    }
+    for (int32_t end = length - 1; end > 0; --end) {
+        float swap = values[0];
+        values[0] = values[end];
+        values[end] = swap;
+        Clay__SiftDownFloat(values, 0, end);
+    }
+}
+
+// Finds the level that every size below it needs to be raised to (but no further than its limit) so that the sizes grow by amount in total.
+// Works through the sorted sizes and limits once, rather than raising the smallest sizes one step at a time.
+// Sizes with no limit can be left out of limits, and limits must not be smaller than the sizes they belong to.
+// Returns CLAY__MAXFLOAT if every size reaches its limit before amount has been used up.
+float Clay__DistributeSizeLevel(float *sizes, int32_t sizesLength, float *limits, int32_t limitsLength, float amount) {
+    Clay__SortFloats(sizes, sizesLength);
+    Clay__SortFloats(limits, limitsLength);
+    float level = sizes[0];
+    int32_t joined = 0;
+    int32_t left = 0;
+    while (amount > 0) {
+        while (joined < sizesLength && sizes[joined] <= level) {
+            joined++;
+        }
+        while (left < limitsLength && limits[left] <= level) {
+            left++;
+        }
+        int32_t growing = joined - left;
+        float nextLevel = CLAY__MAXFLOAT;
+        if (joined < sizesLength) {
+            nextLevel = sizes[joined];
+        }
+        if (left < limitsLength) {
+            nextLevel = CLAY__MIN(nextLevel, limits[left]);
+        }
+        if (nextLevel == CLAY__MAXFLOAT) {
+            // Every size has reached its limit, so none of them stop the level rising
+            return growing > 0 ? level + amount / (float)growing : CLAY__MAXFLOAT;
+        }
+        if (growing > 0) {
+            float needed = (nextLevel - level) * (float)growing;
+            if (needed >= amount) {
+                level += amount / (float)growing;
+                break;
+            }
+            amount -= needed;
+        }
+        level = nextLevel;
+    }
+    return level;
+}
+
+// Sizes the children of a single parent along one axis. Each parent only writes to its own children, so parents that are
+// on the same level of the tree can be sized at the same time, given separate resizable container and size distribution buffers.
+// Runs on the threads of layout tasks, so it only reads and writes the context it is given, and never reports errors or warnings.
+// The scratch buffers must have room for an index and two floats for every child of parent, see Clay__SizeContainersAlongAxis().
+void Clay__SizeChildrenAlongAxis(Clay_Context *context, Clay_LayoutElement *parent, bool xAxis, int32_t *resizableContainerBuffer, float *sizeDistributionBuffer) {
+    Clay_LayoutElement *layoutElements = context->layoutElements.internalArray;
+    // Exiting elements are cloned beyond the end of the arrays, so they're indexed directly rather than checked against length
+    Clay__LayoutElementData *layoutElementData = context->layoutElementData.internalArray;
+    Clay_LayoutConfig *parentLayoutConfig = &parent->layout;
+    int32_t parentClipIndex = layoutElementData[parent - layoutElements].configIndices.clip;
+    Clay_ClipElementConfig *parentClipConfig = parentClipIndex ? &context->clipConfigs.internalArray[parentClipIndex] : &Clay_ClipElementConfig_DEFAULT;
+    int32_t growContainerCount = 0;
+    float parentSize = xAxis ? parent->dimensions.width : parent->dimensions.height;
+    float parentPadding = (float)(xAxis ? (parentLayoutConfig->padding.left + parentLayoutConfig->padding.right) : (parentLayoutConfig->padding.top + parentLayoutConfig->padding.bottom));
+    float innerContentSize = 0, totalPaddingAndChildGaps = parentPadding;
+    bool sizingAlongAxis = (xAxis && parentLayoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentLayoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
+    int32_t resizableContainerCount = 0;
+    float parentChildGap = parentLayoutConfig->childGap;
+    bool isFirstChild = true;
+
+    for (int32_t childOffset = 0; childOffset < parent->children.length; childOffset++) {
+        int32_t childElementIndex = parent->children.elements[childOffset];
+        Clay_LayoutElement *childElement = &layoutElements[childElementIndex];
+        Clay_SizingAxis childSizing = Clay__GetElementSizing(childElement, xAxis);
+        float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
+
+        // Note: setting isFirstChild = false is skipped here
+        if (childElement->exiting) {
+            continue;
+        }
+
+        if (childSizing.type != CLAY__SIZING_TYPE_PERCENT
+            && childSizing.type != CLAY__SIZING_TYPE_FIXED
+            && (!childElement->isTextElement || layoutElementData[childElementIndex].textConfig.wrapMode == CLAY_TEXT_WRAP_WORDS)
+//                    && (xAxis || !Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_ASPECT))
+        ) {
+            resizableContainerBuffer[resizableContainerCount++] = childElementIndex;
+        }
+
+        if (sizingAlongAxis) {
+            innerContentSize += (childSizing.type == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
+            if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
+                growContainerCount++;
+            }
+            if (!isFirstChild) {
+                innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
+                totalPaddingAndChildGaps += parentChildGap;
+            }
+        } else {
+            innerContentSize = CLAY__MAX(childSize, innerContentSize);
+        }
+        isFirstChild = false;
+    }
+
+    // If neither this element's subtree nor its size has changed since last frame, its children will be sized exactly as they were
+    if (context->incrementalLayoutActive && Clay__LayoutElementIsUnchanged(context, parent, xAxis)) {
+        for (int32_t childOffset = 0; childOffset < parent->children.length; childOffset++) {
+            Clay_LayoutElement *childElement = &layoutElements[parent->children.elements[childOffset]];
+            Clay_LayoutElementHashMapItem *childItem = Clay__GetHashMapItemFromContext(context, childElement->id);
+            if (xAxis) {
+                childElement->dimensions.width = childItem->layoutDimensions.width;
+            } else {
+                childElement->dimensions.height = childItem->layoutDimensions.height;
+            }
+        }
+        return;
+    }
+
+    // Expand percentage containers to size
+    for (int32_t childOffset = 0; childOffset < parent->children.length; childOffset++) {
+        Clay_LayoutElement *childElement = &layoutElements[parent->children.elements[childOffset]];
+        Clay_SizingAxis childSizing = Clay__GetElementSizing(childElement, xAxis);
+        float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
+        if (childSizing.type == CLAY__SIZING_TYPE_PERCENT) {
+            *childSize = (parentSize - totalPaddingAndChildGaps) * childSizing.size.percent;
+            if (sizingAlongAxis) {
+                innerContentSize += *childSize;
+            }
+            Clay__UpdateAspectRatioBox(childElement);
+        }
+    }
+
+    if (sizingAlongAxis) {
+        float sizeToDistribute = parentSize - parentPadding - innerContentSize;
+        // The content is too large, compress the children as much as possible
+        if (sizeToDistribute < 0) {
+            // If the parent clips content in this axis direction, don't compress children, just leave them alone
+            if (((xAxis && parentClipConfig->horizontal) || (!xAxis && parentClipConfig->vertical))) {
+                return;
+            }
+            // Shrink the largest children down to a common level, no further than their minimum sizes.
+            // Sizes are negated so that the same level finding function as growing can be used.
+            // A child that is already smaller than its minimum size is snapped up to it once the level passes it, which leaves more to take from the others.
+            float level = CLAY__MAXFLOAT;
+            int32_t snappedCount = -1;
+            while (resizableContainerCount > 0) {
+                float *sizes = sizeDistributionBuffer;
+                float *limits = sizes + resizableContainerCount;
+                float snappedSize = 0;
+                int32_t sizesLength = 0;
+                int32_t previousSnappedCount = snappedCount;
+                snappedCount = 0;
+                for (int childIndex = 0; childIndex < resizableContainerCount; childIndex++) {
+                    Clay_LayoutElement *child = &layoutElements[resizableContainerBuffer[childIndex]];
+                    float childSize = xAxis ? child->dimensions.width : child->dimensions.height;
+                    float minSize = xAxis ? child->minDimensions.width : child->minDimensions.height;
+                    if (minSize > childSize) {
+                        if (childSize > level) {
+                            snappedSize += minSize - childSize;
+                            snappedCount++;
+                        }
+                        continue;
+                    }
+                    sizes[sizesLength] = -childSize;
+                    limits[sizesLength] = -minSize;
+                    sizesLength++;
+                }
+                if (snappedCount == previousSnappedCount) {
+                    break;
+                }
+                level = sizesLength > 0 ? -Clay__DistributeSizeLevel(sizes, sizesLength, limits, sizesLength, snappedSize - sizeToDistribute) : -CLAY__MAXFLOAT;
+            }
+            for (int childIndex = 0; childIndex < resizableContainerCount; childIndex++) {
+                Clay_LayoutElement *child = &layoutElements[resizableContainerBuffer[childIndex]];
+                float *childSize = xAxis ? &child->dimensions.width : &child->dimensions.height;
+                float minSize = xAxis ? child->minDimensions.width : child->minDimensions.height;
+                if (*childSize > level) {
+                    *childSize = CLAY__MAX(level, minSize);
+                }
+            }
+        // The content is too small, allow SIZING_GROW containers to expand
+        } else if (sizeToDistribute > 0 && growContainerCount > 0) {
+            for (int childIndex = 0; childIndex < resizableContainerCount; childIndex++) {
+                Clay_LayoutElement *child = &layoutElements[resizableContainerBuffer[childIndex]];
+                Clay__SizingType childSizing = Clay__GetElementSizing(child, xAxis).type;
+                if (childSizing != CLAY__SIZING_TYPE_GROW) {
+                    resizableContainerBuffer[childIndex--] = resizableContainerBuffer[--resizableContainerCount];
+                }
+            }
+            // Grow the smallest children up to a common level, no further than their maximum sizes.
+            // A child that is already larger than its maximum size is snapped down to it once the level passes it, which leaves more to give to the others.
+            float level = -CLAY__MAXFLOAT;
+            int32_t snappedCount = -1;
+            while (resizableContainerCount > 0) {
+                float *sizes = sizeDistributionBuffer;
+                float *limits = sizes + resizableContainerCount;
+                float snappedSize = 0;
+                int32_t sizesLength = 0;
+                int32_t limitsLength = 0;
+                int32_t previousSnappedCount = snappedCount;
+                snappedCount = 0;
+                for (int childIndex = 0; childIndex < resizableContainerCount; childIndex++) {
+                    Clay_LayoutElement *child = &layoutElements[resizableContainerBuffer[childIndex]];
+                    float childSize = xAxis ? child->dimensions.width : child->dimensions.height;
+                    float maxSize = Clay__GetElementSizing(child, xAxis).size.minMax.max;
+                    if (maxSize < childSize) {
+                        if (childSize < level) {
+                            snappedSize += childSize - maxSize;
+                            snappedCount++;
+                        }
+                        continue;
+                    }
+                    sizes[sizesLength++] = childSize;
+                    if (maxSize < CLAY__MAXFLOAT) {
+                        limits[limitsLength++] = maxSize;
+                    }
+                }
+                if (snappedCount == previousSnappedCount) {
+                    break;
+                }
+                level = sizesLength > 0 ? Clay__DistributeSizeLevel(sizes, sizesLength, limits, limitsLength, sizeToDistribute + snappedSize) : CLAY__MAXFLOAT;
+            }
+            for (int childIndex = 0; childIndex < resizableContainerCount; childIndex++) {
+                Clay_LayoutElement *child = &layoutElements[resizableContainerBuffer[childIndex]];
+                float *childSize = xAxis ? &child->dimensions.width : &child->dimensions.height;
+                float maxSize = Clay__GetElementSizing(child, xAxis).size.minMax.max;
+                if (*childSize < level) {
+                    *childSize = CLAY__MIN(level, maxSize);
+                }
+            }
+        }
+    // Sizing along the non layout axis ("off axis")
+    } else {
+        for (int32_t childOffset = 0; childOffset < resizableContainerCount; childOffset++) {
+            Clay_LayoutElement *childElement = &layoutElements[resizableContainerBuffer[childOffset]];
+            Clay_SizingAxis childSizing = Clay__GetElementSizing(childElement, xAxis);
+            float minSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
+            float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
+
+            float maxSize = parentSize - parentPadding;
+            // If we're laying out the children of a scroll panel, grow containers expand to the size of the inner content, not the outer container
+            if (((xAxis && parentClipConfig->horizontal) || (!xAxis && parentClipConfig->vertical))) {
+                maxSize = CLAY__MAX(maxSize, innerContentSize);
+            }
+            if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
+                *childSize = CLAY__MIN(maxSize, childSizing.size.minMax.max);
+            }
+            *childSize = CLAY__MAX(minSize, CLAY__MIN(*childSize, maxSize));
+        }
+    }
 }
 
-void Clay__ConfigureOpenElement(const Clay_ElementDeclaration declaration) {
-    Clay__ConfigureOpenElementPtr(&declaration);
-}
-
-void Clay__InitializeEphemeralMemory(Clay_Context* context) {
-    int32_t maxElementCount = context->maxElementCount;
-    // Ephemeral Memory - reset every frame
-    Clay_Arena *arena = &context->internalArena;
-    arena->nextAllocation = context->arenaResetOffset;
-
-    context->layoutElementChildrenBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElements = Clay_LayoutElementArray_Allocate_Arena(maxElementCount, arena);
-    context->warnings = Clay__WarningArray_Allocate_Arena(100, arena);
-
-    context->layoutElementIdStrings = Clay__StringArray_Allocate_Arena(maxElementCount, arena);
-    context->wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementTreeNodeArray1 = Clay__LayoutElementTreeNodeArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementChildren = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->openLayoutElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->renderCommands = Clay_RenderCommandArray_Allocate_Arena(maxElementCount, arena);
-    context->treeNodeVisited = Clay__boolArray_Allocate_Arena(maxElementCount, arena);
-    context->treeNodeVisited.length = context->treeNodeVisited.capacity; // This array is accessed directly rather than behaving as a list
-    context->openClipElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->dynamicStringData = Clay__charArray_Allocate_Arena(maxElementCount, arena);
-}
-
-void Clay__InitializePersistentMemory(Clay_Context* context) {
-    // Persistent memory - initialized once and not reset
-    int32_t maxElementCount = context->maxElementCount;
-    int32_t maxMeasureTextCacheWordCount = context->maxMeasureTextCacheWordCount;
-    Clay_Arena *arena = &context->internalArena;
-
-    context->scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(100, arena);
-    context->transitionDatas = Clay__TransitionDataInternalArray_Allocate_Arena(200, arena);
-    context->layoutElementsHashMapInternal = Clay__LayoutElementHashMapItemArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementsHashMap = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementsHashMapFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->measureTextHashMapInternal = Clay__MeasureTextCacheItemArray_Allocate_Arena(maxElementCount, arena);
-    context->measureTextHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->measuredWordsFreeList = Clay__int32_tArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
-    context->measureTextHashMap = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->measuredWords = Clay__MeasuredWordArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
-    context->pointerOverIds = Clay_ElementIdArray_Allocate_Arena(maxElementCount, arena);
-    context->arenaResetOffset = arena->nextAllocation;
-}
-
-const float CLAY__EPSILON = 0.01;
+// Queues the children of a parent that still need sizing, in the same order for both the serial and parallel paths.
+void Clay__QueueChildrenForSizing(Clay_LayoutElement *parent, Clay__int32_tArray *bfsBuffer, Clay__int32_tArray* textElementsOut, Clay__int32_tArray* aspectRatioElementsOut) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t childOffset = 0; childOffset < parent->children.length; childOffset++) {
+        int32_t childElementIndex = parent->children.elements[childOffset];
+        Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+        if (textElementsOut && childElement->isTextElement) {
+            Clay__int32_tArray_Add(textElementsOut, childElementIndex);
+        } else if (childElement->children.length > 0) {
+            Clay__int32_tArray_Add(bfsBuffer, childElementIndex);
+        }
 
-bool Clay__FloatEqual(float left, float right) {
-    float subtracted = left - right;
-    return subtracted < CLAY__EPSILON && subtracted > -CLAY__EPSILON;
+        if (!childElement->isTextElement && aspectRatioElementsOut && childElement->aspectRatio.aspectRatio != 0) {
+            Clay__int32_tArray_Add(aspectRatioElementsOut, childElementIndex);
+        }
+    }
 }
 
-Clay_SizingAxis Clay__GetElementSizing(Clay_LayoutElement* element, bool xAxis) {
-    if (element->isTextElement) {
-        return CLAY__INIT(Clay_SizingAxis) {};
-    } else {
-        return xAxis ? element->config.layout.sizing.width : element->config.layout.sizing.height;
+typedef struct {
+    Clay_Context *context;
+    Clay__int32_tArray parents;
+    bool xAxis;
+    int32_t taskParentStarts[CLAY__LAYOUT_TASK_MAX_COUNT + 1];
+    int32_t taskScratchOffsets[CLAY__LAYOUT_TASK_MAX_COUNT];
+} Clay__SizingTaskData;
+
+void Clay__SizeChildrenAlongAxisTask(int32_t taskIndex, void *taskData) {
+    Clay__SizingTaskData *data = (Clay__SizingTaskData *)taskData;
+    Clay_Context* context = data->context;
+    // Each task gets a disjoint slice of the scratch buffers, large enough for all of the children in its range of parents
+    int32_t scratchOffset = data->taskScratchOffsets[taskIndex];
+    int32_t *resizableContainerBuffer = context->openLayoutElementStack.internalArray + scratchOffset;
+    float *sizeDistributionBuffer = (float *)context->layoutElementTreeNodeArray1.internalArray + scratchOffset * 2;
+    for (int32_t i = data->taskParentStarts[taskIndex]; i < data->taskParentStarts[taskIndex + 1]; ++i) {
+        Clay__SizeChildrenAlongAxis(context, &context->layoutElements.internalArray[data->parents.internalArray[i]], data->xAxis, resizableContainerBuffer, sizeDistributionBuffer);
     }
 }
 
@@ -2281,7 +4274,6 @@ Clay_SizingAxis Clay__GetElementSizing(Clay_LayoutElement* element, bool xAxis)
 void Clay__SizeContainersAlongAxis(bool xAxis, float deltaTime, Clay__int32_tArray* textElementsOut, Clay__int32_tArray* aspectRatioElementsOut) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__int32_tArray bfsBuffer = context->layoutElementChildrenBuffer;
-    Clay__int32_tArray resizableContainerBuffer = context->openLayoutElementStack;
     for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
         bfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
@@ -2289,29 +4281,29 @@ void Clay__SizeContainersAlongAxis(bool xAxis, float deltaTime, Clay__int32_tArr
         Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
 
         // Size floating containers to their parents
-        if (rootElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE) {
-            Clay_FloatingElementConfig *floatingElementConfig = &rootElement->config.floating;
+        Clay_FloatingElementConfig *floatingElementConfig = Clay__GetFloatingConfig(Clay__GetLayoutElementData(rootElement));
+        if (floatingElementConfig->attachTo != CLAY_ATTACH_TO_NONE) {
             Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingElementConfig->parentId);
             if (parentItem && parentItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
                 Clay_LayoutElement *parentLayoutElement = parentItem->layoutElement;
-                switch (rootElement->config.layout.sizing.width.type) {
+                switch (rootElement->layout.sizing.width.type) {
                     case CLAY__SIZING_TYPE_GROW: {
                         rootElement->dimensions.width = parentLayoutElement->dimensions.width;
                         break;
                     }
                     case CLAY__SIZING_TYPE_PERCENT: {
-                        rootElement->dimensions.width = parentLayoutElement->dimensions.width * rootElement->config.layout.sizing.width.size.percent;
+                        rootElement->dimensions.width = parentLayoutElement->dimensions.width * rootElement->layout.sizing.width.size.percent;
                         break;
                     }
                     default: break;
                 }
-                switch (rootElement->config.layout.sizing.height.type) {
+                switch (rootElement->layout.sizing.height.type) {
                     case CLAY__SIZING_TYPE_GROW: {
                         rootElement->dimensions.height = parentLayoutElement->dimensions.height;
                         break;
                     }
                     case CLAY__SIZING_TYPE_PERCENT: {
-                        rootElement->dimensions.height = parentLayoutElement->dimensions.height * rootElement->config.layout.sizing.height.size.percent;
+                        rootElement->dimensions.height = parentLayoutElement->dimensions.height * rootElement->layout.sizing.height.size.percent;
                         break;
                     }
                     default: break;
@@ -2319,195 +4311,46 @@ void Clay__SizeContainersAlongAxis(bool xAxis, float deltaTime, Clay__int32_tArr
             }
         }
 
-        if (rootElement->config.layout.sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
-            rootElement->dimensions.width = CLAY__MIN(CLAY__MAX(rootElement->dimensions.width, rootElement->config.layout.sizing.width.size.minMax.min), rootElement->config.layout.sizing.width.size.minMax.max);
+        if (rootElement->layout.sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
+            rootElement->dimensions.width = CLAY__MIN(CLAY__MAX(rootElement->dimensions.width, rootElement->layout.sizing.width.size.minMax.min), rootElement->layout.sizing.width.size.minMax.max);
         }
-        if (rootElement->config.layout.sizing.height.type != CLAY__SIZING_TYPE_PERCENT) {
-            rootElement->dimensions.height = CLAY__MIN(CLAY__MAX(rootElement->dimensions.height, rootElement->config.layout.sizing.height.size.minMax.min), rootElement->config.layout.sizing.height.size.minMax.max);
+        if (rootElement->layout.sizing.height.type != CLAY__SIZING_TYPE_PERCENT) {
+            rootElement->dimensions.height = CLAY__MIN(CLAY__MAX(rootElement->dimensions.height, rootElement->layout.sizing.height.size.minMax.min), rootElement->layout.sizing.height.size.minMax.max);
         }
 
-
-        for (int32_t i = 0; i < bfsBuffer.length; ++i) {
-            int32_t parentIndex = Clay__int32_tArray_GetValue(&bfsBuffer, i);
-            Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex);
-            Clay_LayoutConfig *parentLayoutConfig = &parent->config.layout;
-            int32_t growContainerCount = 0;
-            float parentSize = xAxis ? parent->dimensions.width : parent->dimensions.height;
-            float parentPadding = (float)(xAxis ? (parentLayoutConfig->padding.left + parentLayoutConfig->padding.right) : (parentLayoutConfig->padding.top + parentLayoutConfig->padding.bottom));
-            float innerContentSize = 0, totalPaddingAndChildGaps = parentPadding;
-            bool sizingAlongAxis = (xAxis && parentLayoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentLayoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
-            resizableContainerBuffer.length = 0;
-            float parentChildGap = parentLayoutConfig->childGap;
-            bool isFirstChild = true;
-
-            for (int32_t childOffset = 0; childOffset < parent->children.length; childOffset++) {
-                int32_t childElementIndex = parent->children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = Clay__GetElementSizing(childElement, xAxis);
-                float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
-
-                if (textElementsOut && childElement->isTextElement) {
-                    Clay__int32_tArray_Add(textElementsOut, childElementIndex);
-                } else if (childElement->children.length > 0) {
-                    Clay__int32_tArray_Add(&bfsBuffer, childElementIndex);
-                }
-
-                if (!childElement->isTextElement && aspectRatioElementsOut && childElement->config.aspectRatio.aspectRatio != 0) {
-                    Clay__int32_tArray_Add(aspectRatioElementsOut, childElementIndex);
-                }
-
-                // Note: setting isFirstChild = false is skipped here
-                if (childElement->exiting) {
-                    continue;
-                }
-
-                if (childSizing.type != CLAY__SIZING_TYPE_PERCENT
-                    && childSizing.type != CLAY__SIZING_TYPE_FIXED
-                    && (!childElement->isTextElement || childElement->textConfig.wrapMode == CLAY_TEXT_WRAP_WORDS)
-//                    && (xAxis || !Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_ASPECT))
-                ) {
-                    Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
-                }
-
-                if (sizingAlongAxis) {
-                    innerContentSize += (childSizing.type == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
-                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        growContainerCount++;
-                    }
-                    if (!isFirstChild) {
-                        innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
-                        totalPaddingAndChildGaps += parentChildGap;
-                    }
-                } else {
-                    innerContentSize = CLAY__MAX(childSize, innerContentSize);
-                }
-                isFirstChild = false;
-            }
-
-            // Expand percentage containers to size
-            for (int32_t childOffset = 0; childOffset < parent->children.length; childOffset++) {
-                int32_t childElementIndex = parent->children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = Clay__GetElementSizing(childElement, xAxis);
-                float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-                if (childSizing.type == CLAY__SIZING_TYPE_PERCENT) {
-                    *childSize = (parentSize - totalPaddingAndChildGaps) * childSizing.size.percent;
-                    if (sizingAlongAxis) {
-                        innerContentSize += *childSize;
-                    }
-                    Clay__UpdateAspectRatioBox(childElement);
-                }
+        // The tree is sized one level at a time, because a parent's size must be known before its children can be sized
+        int32_t levelStart = 0;
+        while (levelStart < bfsBuffer.length) {
+            int32_t levelEnd = bfsBuffer.length;
+            int32_t levelChildCount = 0;
+            for (int32_t i = levelStart; i < levelEnd; ++i) {
+                levelChildCount += Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&bfsBuffer, i))->children.length;
             }
-
-            if (sizingAlongAxis) {
-                float sizeToDistribute = parentSize - parentPadding - innerContentSize;
-                // The content is too large, compress the children as much as possible
-                if (sizeToDistribute < 0) {
-                    // If the parent clips content in this axis direction, don't compress children, just leave them alone
-                    if (((xAxis && parent->config.clip.horizontal) || (!xAxis && parent->config.clip.vertical))) {
-                        continue;
-                    }
-                    // Scrolling containers preferentially compress before others
-                    while (sizeToDistribute < -CLAY__EPSILON && resizableContainerBuffer.length > 0) {
-                        float largest = 0;
-                        float secondLargest = 0;
-                        float widthToAdd = sizeToDistribute;
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float childSize = xAxis ? child->dimensions.width : child->dimensions.height;
-                            if (Clay__FloatEqual(childSize, largest)) { continue; }
-                            if (childSize > largest) {
-                                secondLargest = largest;
-                                largest = childSize;
-                            }
-                            if (childSize < largest) {
-                                secondLargest = CLAY__MAX(secondLargest, childSize);
-                                widthToAdd = secondLargest - largest;
-                            }
-                        }
-
-                        widthToAdd = CLAY__MAX(widthToAdd, sizeToDistribute / resizableContainerBuffer.length);
-
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float *childSize = xAxis ? &child->dimensions.width : &child->dimensions.height;
-                            float minSize = xAxis ? child->minDimensions.width : child->minDimensions.height;
-                            float previousWidth = *childSize;
-                            if (Clay__FloatEqual(*childSize, largest)) {
-                                *childSize += widthToAdd;
-                                if (*childSize <= minSize) {
-                                    *childSize = minSize;
-                                    Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
-                                }
-                                sizeToDistribute -= (*childSize - previousWidth);
-                            }
-                        }
-                    }
-                // The content is too small, allow SIZING_GROW containers to expand
-                } else if (sizeToDistribute > 0 && growContainerCount > 0) {
-                    for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                        Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                        Clay__SizingType childSizing = Clay__GetElementSizing(child, xAxis).type;
-                        if (childSizing != CLAY__SIZING_TYPE_GROW) {
-                            Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
-                        }
-                    }
-                    while (sizeToDistribute > CLAY__EPSILON && resizableContainerBuffer.length > 0) {
-                        float smallest = CLAY__MAXFLOAT;
-                        float secondSmallest = CLAY__MAXFLOAT;
-                        float widthToAdd = sizeToDistribute;
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float childSize = xAxis ? child->dimensions.width : child->dimensions.height;
-                            if (Clay__FloatEqual(childSize, smallest)) { continue; }
-                            if (childSize < smallest) {
-                                secondSmallest = smallest;
-                                smallest = childSize;
-                            }
-                            if (childSize > smallest) {
-                                secondSmallest = CLAY__MIN(secondSmallest, childSize);
-                                widthToAdd = secondSmallest - smallest;
-                            }
-                        }
-
-                        widthToAdd = CLAY__MIN(widthToAdd, sizeToDistribute / resizableContainerBuffer.length);
-
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float *childSize = xAxis ? &child->dimensions.width : &child->dimensions.height;
-                            Clay_SizingAxis childSizing = Clay__GetElementSizing(child, xAxis);
-                            float maxSize = childSizing.size.minMax.max;
-                            float previousWidth = *childSize;
-                            if (Clay__FloatEqual(*childSize, smallest)) {
-                                *childSize += widthToAdd;
-                                if (*childSize >= maxSize) {
-                                    *childSize = maxSize;
-                                    Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
-                                }
-                                sizeToDistribute -= (*childSize - previousWidth);
-                            }
-                        }
+            int32_t taskCount = CLAY__MIN(levelChildCount / CLAY__LAYOUT_TASK_MIN_CHILD_COUNT, CLAY__LAYOUT_TASK_MAX_COUNT);
+            if (context->layoutTaskDispatchFunction && taskCount > 1 && levelEnd - levelStart > 1) {
+                // Split the level into ranges of parents with roughly the same number of children
+                Clay__SizingTaskData taskData = { .context = context, .parents = bfsBuffer, .xAxis = xAxis };
+                int32_t childCount = 0;
+                int32_t tasksStarted = 0;
+                for (int32_t i = levelStart; i < levelEnd && tasksStarted < taskCount; ++i) {
+                    if (childCount >= (int32_t)((int64_t)levelChildCount * tasksStarted / taskCount)) {
+                        taskData.taskParentStarts[tasksStarted] = i;
+                        taskData.taskScratchOffsets[tasksStarted] = childCount;
+                        tasksStarted++;
                     }
+                    childCount += Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&bfsBuffer, i))->children.length;
                 }
-            // Sizing along the non layout axis ("off axis")
+                taskData.taskParentStarts[tasksStarted] = levelEnd;
+                context->layoutTaskDispatchFunction(Clay__SizeChildrenAlongAxisTask, &taskData, tasksStarted, context->layoutTaskDispatchUserData);
             } else {
-                for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
-                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
-                    Clay_SizingAxis childSizing = Clay__GetElementSizing(childElement, xAxis);
-                    float minSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
-                    float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-
-                    float maxSize = parentSize - parentPadding;
-                    // If we're laying out the children of a scroll panel, grow containers expand to the size of the inner content, not the outer container
-                    if (((xAxis && parent->config.clip.horizontal) || (!xAxis && parent->config.clip.vertical))) {
-                        maxSize = CLAY__MAX(maxSize, innerContentSize);
-                    }
-                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        *childSize = CLAY__MIN(maxSize, childSizing.size.minMax.max);
-                    }
-                    *childSize = CLAY__MAX(minSize, CLAY__MIN(*childSize, maxSize));
+                for (int32_t i = levelStart; i < levelEnd; ++i) {
+                    Clay__SizeChildrenAlongAxis(context, Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&bfsBuffer, i)), xAxis, context->openLayoutElementStack.internalArray, (float *)context->layoutElementTreeNodeArray1.internalArray);
                 }
             }
+            for (int32_t i = levelStart; i < levelEnd; ++i) {
+                Clay__QueueChildrenForSizing(Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&bfsBuffer, i)), &bfsBuffer, textElementsOut, aspectRatioElementsOut);
+            }
+            levelStart = levelEnd;
         }
     }
 }
@@ -2517,6 +4360,12 @@ Clay_String Clay__IntToString(int32_t integer) {
         return CLAY__INIT(Clay_String) { .length = 1, .chars = "0" };
     }
     Clay_Context* context = Clay_GetCurrentContext();
+    // The longest string is 11 characters, for -2147483647
+    if (context->dynamicStringData.length + 11 > context->dynamicStringData.capacity) {
+        context->booleanWarnings.dynamicStringDataCapacityExceeded = true;
+        Clay__CapacityExceeded();
+        return CLAY__STRING_DEFAULT;
+    }
     char *chars = (char *)(context->dynamicStringData.internalArray + context->dynamicStringData.length);
     int32_t length = 0;
     int32_t sign = integer;
@@ -2548,13 +4397,13 @@ void Clay__AddRenderCommand(Clay_RenderCommand renderCommand) {
     if (context->renderCommands.length < context->renderCommands.capacity - 1) {
         Clay_RenderCommandArray_Add(&context->renderCommands, renderCommand);
     } else {
-        if (!context->booleanWarnings.maxRenderCommandsExceeded) {
-            context->booleanWarnings.maxRenderCommandsExceeded = true;
+        if (!context->booleanWarnings.maxRenderCommandsExceeded && Clay__CapacityExceeded()) {
             context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                 .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
-                .errorText = CLAY_STRING("Clay ran out of capacity while attempting to create render commands. This is usually caused by a large amount of wrapping text elements while close to the max element capacity. Try using Clay_SetMaxElementCount() with a higher value."),
+                .errorText = CLAY_STRING("Clay ran out of capacity while attempting to create render commands. This is usually caused by a large amount of wrapping text elements while close to the max element capacity. Try using Clay_SetMaxRenderCommandCount() or Clay_SetMaxElementCount() with a higher value."),
                 .userData = context->errorHandler.userData });
         }
+        context->booleanWarnings.maxRenderCommandsExceeded = true;
     }
 }
 
@@ -2570,8 +4419,130 @@ bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
            (boundingBox->y + boundingBox->height < 0);
 }
 
+bool Clay__ElementIsClipped(Clay_BoundingBox *boundingBox, Clay_BoundingBox *clipBoundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->disableCulling) {
+        return false;
+    }
+
+    return (boundingBox->x > clipBoundingBox->x + clipBoundingBox->width) ||
+           (boundingBox->y > clipBoundingBox->y + clipBoundingBox->height) ||
+           (boundingBox->x + boundingBox->width < clipBoundingBox->x) ||
+           (boundingBox->y + boundingBox->height < clipBoundingBox->y);
+}
+
+// Narrows a clip region to the bounding box of a clip element, on the axes that it clips
+Clay_BoundingBox Clay__IntersectClipBoundingBox(Clay_BoundingBox clipBoundingBox, Clay_BoundingBox *boundingBox, Clay_ClipElementConfig *clipConfig) {
+    if (clipConfig->horizontal) {
+        float right = CLAY__MIN(clipBoundingBox.x + clipBoundingBox.width, boundingBox->x + boundingBox->width);
+        clipBoundingBox.x = CLAY__MAX(clipBoundingBox.x, boundingBox->x);
+        clipBoundingBox.width = right - clipBoundingBox.x;
+    }
+    if (clipConfig->vertical) {
+        float bottom = CLAY__MIN(clipBoundingBox.y + clipBoundingBox.height, boundingBox->y + boundingBox->height);
+        clipBoundingBox.y = CLAY__MAX(clipBoundingBox.y, boundingBox->y);
+        clipBoundingBox.height = bottom - clipBoundingBox.y;
+    }
+    return clipBoundingBox;
+}
+
+// Sort tree roots by z-index
+void Clay__SortLayoutElementTreeRoots(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t length = context->layoutElementTreeRoots.length;
+    Clay__LayoutElementTreeRoot *source = context->layoutElementTreeRoots.internalArray;
+    // Most layouts declare their roots in z order already
+    bool sorted = true;
+    for (int32_t i = 1; i < length; ++i) {
+        if (source[i].zIndex < source[i - 1].zIndex) {
+            sorted = false;
+            break;
+        }
+    }
+    if (sorted) {
+        return;
+    }
+    // Bottom up merge sort, which is stable so that roots with the same zIndex keep their declaration order
+    Clay__LayoutElementTreeRoot *destination = context->layoutElementTreeRootsSortBuffer.internalArray;
+    for (int32_t width = 1; width < length; width *= 2) {
+        for (int32_t left = 0; left < length; left += width * 2) {
+            int32_t middle = CLAY__MIN(left + width, length);
+            int32_t right = CLAY__MIN(left + width * 2, length);
+            int32_t i = left;
+            int32_t j = middle;
+            int32_t k = left;
+            while (i < middle && j < right) {
+                destination[k++] = source[j].zIndex < source[i].zIndex ? source[j++] : source[i++];
+            }
+            while (i < middle) {
+                destination[k++] = source[i++];
+            }
+            while (j < right) {
+                destination[k++] = source[j++];
+            }
+        }
+        Clay__LayoutElementTreeRoot *swap = source;
+        source = destination;
+        destination = swap;
+    }
+    if (source != context->layoutElementTreeRoots.internalArray) {
+        for (int32_t i = 0; i < length; ++i) {
+            context->layoutElementTreeRoots.internalArray[i] = source[i];
+        }
+    }
+}
+
+// Measures the text that was deferred for Clay_SetMeasureTextBatchFunction(), then sizes the text elements that were waiting on it
+// and the ancestors that fit them again.
+void Clay__MeasurePendingText(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->pendingTextMeasurements.length == 0) {
+        return;
+    }
+    Clay__MeasureDeferredTextCacheItems();
+    // Children are always stored after their parents, so walking backwards sizes every child before its parent
+    for (int32_t i = context->layoutElements.length - 1; i >= 0; --i) {
+        Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, i);
+        if (!layoutElement->textMeasurementPending) {
+            continue;
+        }
+        layoutElement->textMeasurementPending = false;
+        Clay__LayoutElementData *elementData = Clay__GetLayoutElementData(layoutElement);
+        if (layoutElement->isTextElement) {
+            Clay__SetTextElementDimensions(layoutElement, elementData, Clay__MeasureTextCached(&elementData->textElementData.text, elementData->textElementData.contentsHash, &elementData->textConfig));
+        // Elements that were never closed have no children attached
+        } else if (!context->booleanWarnings.maxElementsExceeded) {
+            Clay__SizeElementToChildren(layoutElement);
+        }
+    }
+}
+
+// Stores the lines that a text element was wrapped into, so that they can be reused while the width of the element stays the same
+void Clay__CacheWrappedTextLines(Clay__MeasureTextCacheItem *item, Clay__TextElementData *textElementData, float width) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (item == &Clay__MeasureTextCacheItem_DEFAULT) {
+        return;
+    }
+    Clay__FreeMeasuredWordRun(item->wrappedLinesStartIndex, item->wrappedLinesCount);
+    item->wrappedLinesCount = 0;
+    if (textElementData->wrappedLines.length == 0 || !Clay__ReserveMeasuredWords(textElementData->wrappedLines.length, false)) {
+        return;
+    }
+    item->wrappedLinesStartIndex = context->measuredWords.length;
+    item->wrappedLinesCount = textElementData->wrappedLines.length;
+    item->wrappedLinesWidth = width;
+    context->measuredWordRunOwners.internalArray[context->measuredWords.length] = (int32_t)(item - context->measureTextHashMapInternal.internalArray);
+    for (int32_t i = 0; i < textElementData->wrappedLines.length; ++i) {
+        Clay__WrappedTextLine *line = &textElementData->wrappedLines.internalArray[i];
+        Clay__MeasuredWordArray_Add(&context->measuredWords, CLAY__INIT(Clay__MeasuredWord) { .startOffset = (int32_t)(line->line.chars - textElementData->text.chars), .length = line->line.length, .width = line->dimensions.width });
+    }
+}
+
 void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bool generateRenderCommands) {
     Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasurePendingText();
+    // Transitions modify element dimensions after sizing, so results from frames with transitions can't be reused
+    context->incrementalLayoutActive = context->incrementalLayoutEnabled && context->transitionDatas.length == 0;
 
     // Calculate sizing along the X axis
     Clay__int32_tArray textElements = context->openClipElementStack;
@@ -2582,24 +4553,44 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
 
     // Wrap text
     for (int32_t textElementIndex = 0; textElementIndex < textElements.length; ++textElementIndex) {
-        Clay_LayoutElement *element = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&textElements, textElementIndex));
-        Clay__TextElementData *textElementData = &element->textElementData;
-        textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &context->wrappedTextLines.internalArray[context->wrappedTextLines.length] };
         Clay_LayoutElement *containerElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&textElements, textElementIndex));
-        Clay__MeasureTextCacheItem *measureTextCacheItem = Clay__MeasureTextCached(&textElementData->text, &containerElement->textConfig);
+        Clay__LayoutElementData *containerElementData = Clay__GetLayoutElementData(containerElement);
+        Clay__TextElementData *textElementData = &containerElementData->textElementData;
+        textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &context->wrappedTextLines.internalArray[context->wrappedTextLines.length] };
+        Clay__MeasureTextCacheItem *measureTextCacheItem = Clay__MeasureTextCached(&textElementData->text, textElementData->contentsHash, &containerElementData->textConfig);
         float lineWidth = 0;
-        float lineHeight = containerElement->textConfig.lineHeight > 0 ? (float)containerElement->textConfig.lineHeight : textElementData->preferredDimensions.height;
+        float lineHeight = containerElementData->textConfig.lineHeight > 0 ? (float)containerElementData->textConfig.lineHeight : textElementData->preferredDimensions.height;
         int32_t lineLengthChars = 0;
         int32_t lineStartOffset = 0;
+        if (context->wrappedTextLines.length == context->wrappedTextLines.capacity) {
+            Clay__WrappedTextLinesCapacityExceeded();
+            continue;
+        }
         if (!measureTextCacheItem->containsNewlines && textElementData->preferredDimensions.width <= containerElement->dimensions.width) {
             Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { containerElement->dimensions,  textElementData->text });
             textElementData->wrappedLines.length++;
             continue;
         }
-        float spaceWidth = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, &containerElement->textConfig, context->measureTextUserData).width;
+        // The text was already wrapped at this width in an earlier frame
+        if (measureTextCacheItem->wrappedLinesCount > 0 && measureTextCacheItem->wrappedLinesWidth == containerElement->dimensions.width) {
+            for (int32_t i = 0; i < measureTextCacheItem->wrappedLinesCount; ++i) {
+                if (context->wrappedTextLines.length > context->wrappedTextLines.capacity - 1) {
+                    Clay__WrappedTextLinesCapacityExceeded();
+                    break;
+                }
+                Clay__MeasuredWord *line = Clay__MeasuredWordArray_Get(&context->measuredWords, measureTextCacheItem->wrappedLinesStartIndex + i);
+                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { line->width, lineHeight }, { .length = line->length, .chars = &textElementData->text.chars[line->startOffset] } });
+                textElementData->wrappedLines.length++;
+            }
+            containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
+            continue;
+        }
+        float spaceWidth = measureTextCacheItem->spaceWidth;
         int32_t wordIndex = measureTextCacheItem->measuredWordsStartIndex;
-        while (wordIndex != -1) {
+        int32_t wordsEnd = measureTextCacheItem->measuredWordsStartIndex + measureTextCacheItem->measuredWordsCount;
+        while (wordIndex < wordsEnd) {
             if (context->wrappedTextLines.length > context->wrappedTextLines.capacity - 1) {
+                Clay__WrappedTextLinesCapacityExceeded();
                 break;
             }
             Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
@@ -2607,7 +4598,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
             if (lineLengthChars == 0 && lineWidth + measuredWord->width > containerElement->dimensions.width) {
                 Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { measuredWord->width, lineHeight }, { .length = measuredWord->length, .chars = &textElementData->text.chars[measuredWord->startOffset] } });
                 textElementData->wrappedLines.length++;
-                wordIndex = measuredWord->next;
+                wordIndex++;
                 lineStartOffset = measuredWord->startOffset + measuredWord->length;
             }
             // measuredWord->length == 0 means a newline character
@@ -2617,29 +4608,33 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                 Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth + (finalCharIsSpace ? -spaceWidth : 0), lineHeight }, { .length = lineLengthChars + (finalCharIsSpace ? -1 : 0), .chars = &textElementData->text.chars[lineStartOffset] } });
                 textElementData->wrappedLines.length++;
                 if (lineLengthChars == 0 || measuredWord->length == 0) {
-                    wordIndex = measuredWord->next;
+                    wordIndex++;
                 }
                 lineWidth = 0;
                 lineLengthChars = 0;
                 lineStartOffset = measuredWord->startOffset;
             } else {
-                lineWidth += measuredWord->width + containerElement->textConfig.letterSpacing;
+                lineWidth += measuredWord->width + containerElementData->textConfig.letterSpacing;
                 lineLengthChars += measuredWord->length;
-                wordIndex = measuredWord->next;
+                wordIndex++;
             }
         }
-        if (lineLengthChars > 0) {
-            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth - containerElement->textConfig.letterSpacing, lineHeight }, {.length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
+        if (lineLengthChars > 0 && context->wrappedTextLines.length < context->wrappedTextLines.capacity) {
+            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth - containerElementData->textConfig.letterSpacing, lineHeight }, {.length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
             textElementData->wrappedLines.length++;
         }
+        // Lines that were cut short because the wrapped lines array is full aren't cached
+        if (context->wrappedTextLines.length < context->wrappedTextLines.capacity) {
+            Clay__CacheWrappedTextLines(measureTextCacheItem, textElementData, containerElement->dimensions.width);
+        }
         containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
     }
 
     // Scale vertical heights according to aspect ratio
     for (int32_t i = 0; i < aspectRatioElements.length; ++i) {
         Clay_LayoutElement* aspectElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&aspectRatioElements, i));
-        aspectElement->dimensions.height = (1 / aspectElement->config.aspectRatio.aspectRatio) * aspectElement->dimensions.width;
-        aspectElement->config.layout.sizing.height.size.minMax.max = aspectElement->dimensions.height;
+        aspectElement->dimensions.height = (1 / aspectElement->aspectRatio.aspectRatio) * aspectElement->dimensions.width;
+        aspectElement->layout.sizing.height.size.minMax.max = aspectElement->dimensions.height;
     }
 
     // Propagate effect of text wrapping, aspect scaling etc. on height of parents
@@ -2670,7 +4665,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
         dfsBuffer.length--;
 
         // DFS node has been visited, this is on the way back up to the root
-        Clay_LayoutConfig *layoutConfig = &currentElement->config.layout;
+        Clay_LayoutConfig *layoutConfig = &currentElement->layout;
         if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
             // Resize any parent containers that have grown in height along their non layout axis
             for (int32_t j = 0; j < currentElement->children.length; ++j) {
@@ -2696,23 +4691,11 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
     // Scale horizontal widths according to aspect ratio
     for (int32_t i = 0; i < aspectRatioElements.length; ++i) {
         Clay_LayoutElement* aspectElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&aspectRatioElements, i));
-        aspectElement->dimensions.width = aspectElement->config.aspectRatio.aspectRatio * aspectElement->dimensions.height;
-    }
-
-    // Sort tree roots by z-index
-    int32_t sortMax = context->layoutElementTreeRoots.length - 1;
-    while (sortMax > 0) { // todo dumb bubble sort
-        for (int32_t i = 0; i < sortMax; ++i) {
-            Clay__LayoutElementTreeRoot current = *Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, i);
-            Clay__LayoutElementTreeRoot next = *Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, i + 1);
-            if (next.zIndex < current.zIndex) {
-                Clay__LayoutElementTreeRootArray_Set(&context->layoutElementTreeRoots, i, next);
-                Clay__LayoutElementTreeRootArray_Set(&context->layoutElementTreeRoots, i + 1, current);
-            }
-        }
-        sortMax--;
+        aspectElement->dimensions.width = aspectElement->aspectRatio.aspectRatio * aspectElement->dimensions.height;
     }
 
+    Clay__SortLayoutElementTreeRoots();
+
     // Calculate final positions and generate render commands
     context->renderCommands.length = 0;
     dfsBuffer.length = 0;
@@ -2721,11 +4704,12 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
         dfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
         Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
+        Clay__LayoutElementData *rootElementData = Clay__GetLayoutElementData(rootElement);
         Clay_Vector2 rootPosition = CLAY__DEFAULT_STRUCT;
         Clay_LayoutElementHashMapItem *parentHashMapItem = Clay__GetHashMapItem(root->parentId);
         // Position root floating containers
-        if (rootElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE && parentHashMapItem) {
-            Clay_FloatingElementConfig *config = &rootElement->config.floating;
+        Clay_FloatingElementConfig *config = Clay__GetFloatingConfig(rootElementData);
+        if (config->attachTo != CLAY_ATTACH_TO_NONE && parentHashMapItem) {
             Clay_Dimensions rootDimensions = rootElement->dimensions;
             Clay_BoundingBox parentBoundingBox = parentHashMapItem->boundingBox;
             // Set X position
@@ -2778,16 +4762,19 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
             targetAttachPosition.y += config->offset.y;
             rootPosition = targetAttachPosition;
         }
+        Clay_BoundingBox rootClipBoundingBox = { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height };
         if (root->clipElementId) {
             Clay_LayoutElementHashMapItem *clipHashMapItem = Clay__GetHashMapItem(root->clipElementId);
             if (clipHashMapItem && !Clay__ElementIsOffscreen(&clipHashMapItem->boundingBox)) {
+                Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(Clay__GetLayoutElementData(clipHashMapItem->layoutElement));
+                rootClipBoundingBox = Clay__IntersectClipBoundingBox(rootClipBoundingBox, &clipHashMapItem->boundingBox, clipConfig);
                 // Floating elements that are attached to scrolling contents won't be correctly positioned if external scroll handling is enabled, fix here
                 if (context->externalScrollHandlingEnabled) {
-                    if (clipHashMapItem->layoutElement->config.clip.horizontal) {
-                        rootPosition.x += clipHashMapItem->layoutElement->config.clip.childOffset.x;
+                    if (clipConfig->horizontal) {
+                        rootPosition.x += clipConfig->childOffset.x;
                     }
-                    if (clipHashMapItem->layoutElement->config.clip.vertical) {
-                        rootPosition.y += clipHashMapItem->layoutElement->config.clip.childOffset.y;
+                    if (clipConfig->vertical) {
+                        rootPosition.y += clipConfig->childOffset.y;
                     }
                 }
                 if (generateRenderCommands) {
@@ -2801,13 +4788,14 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                 }
             }
         }
-        Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = rootElement, .position = rootPosition, .nextChildOffset = { .x = (float)rootElement->config.layout.padding.left, .y = (float)rootElement->config.layout.padding.top } });
+        Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = rootElement, .position = rootPosition, .nextChildOffset = { .x = (float)rootElement->layout.padding.left, .y = (float)rootElement->layout.padding.top }, .clipBoundingBox = rootClipBoundingBox });
 
         context->treeNodeVisited.internalArray[0] = false;
         while (dfsBuffer.length > 0) {
             Clay__LayoutElementTreeNode *currentElementTreeNode = Clay__LayoutElementTreeNodeArray_Get(&dfsBuffer, (int)dfsBuffer.length - 1);
             Clay_LayoutElement *currentElement = currentElementTreeNode->layoutElement;
-            Clay_LayoutConfig *layoutConfig = currentElement->isTextElement ? &CLAY_LAYOUT_DEFAULT : &currentElement->config.layout;
+            Clay__LayoutElementData *currentElementLayoutData = Clay__GetLayoutElementData(currentElement);
+            Clay_LayoutConfig *layoutConfig = currentElement->isTextElement ? &CLAY_LAYOUT_DEFAULT : &currentElement->layout;
             Clay_Vector2 scrollOffset = CLAY__DEFAULT_STRUCT;
 
             // DFS is returning back upwards
@@ -2817,34 +4805,32 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                     continue;
                 }
                 Clay_LayoutElementHashMapItem *currentElementData = Clay__GetHashMapItem(currentElement->id);
-                if (generateRenderCommands && !Clay__ElementIsOffscreen(&currentElementData->boundingBox)) {
+                if (generateRenderCommands && !currentElementTreeNode->culled) {
                     // DFS is returning upwards backwards
+                    Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(currentElementLayoutData);
+                    Clay_BorderElementConfig *borderConfig = Clay__GetBorderConfig(currentElementLayoutData);
                     bool closeClipElement = false;
-                    if (currentElement->config.clip.horizontal || currentElement->config.clip.vertical) {
+                    if (clipConfig->horizontal || clipConfig->vertical) {
                         closeClipElement = true;
-                        for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-                            Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-                            if (mapping->layoutElement == currentElement) {
-                                scrollOffset = currentElement->config.clip.childOffset;
-                                if (context->externalScrollHandlingEnabled) {
-                                    scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
-                                }
-                                break;
+                        Clay__ScrollContainerDataInternal *mapping = Clay__GetScrollContainerData(currentElementData);
+                        if (mapping && mapping->layoutElement == currentElement) {
+                            scrollOffset = clipConfig->childOffset;
+                            if (context->externalScrollHandlingEnabled) {
+                                scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
                             }
                         }
                     }
 
-                    if (Clay__BorderHasAnyWidth(&currentElement->config.border)) {
+                    if (Clay__BorderHasAnyWidth(borderConfig)) {
                         Clay_BoundingBox currentElementBoundingBox = currentElementData->boundingBox;
-                        Clay_BorderElementConfig *borderConfig = &currentElement->config.border;
                         Clay_RenderCommand renderCommand = {
                             .boundingBox = currentElementBoundingBox,
                             .renderData = { .border = {
                                 .color = borderConfig->color,
-                                .cornerRadius = currentElement->config.cornerRadius,
+                                .cornerRadius = currentElementLayoutData->cornerRadius,
                                 .width = borderConfig->width
                             }},
-                            .userData = currentElement->config.userData,
+                            .userData = currentElementLayoutData->userData,
                             .id = Clay__HashNumber(currentElement->id, currentElement->children.length).id,
                             .commandType = CLAY_RENDER_COMMAND_TYPE_BORDER,
                         };
@@ -2862,7 +4848,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                                                 .renderData = { .rectangle = {
                                                         .backgroundColor = borderConfig->color,
                                                 } },
-                                                .userData = currentElement->config.userData,
+                                                .userData = currentElementLayoutData->userData,
                                                 .id = Clay__HashNumber(currentElement->id, currentElement->children.length + 1 + i).id,
                                                 .commandType = CLAY_RENDER_COMMAND_TYPE_RECTANGLE,
                                         });
@@ -2878,7 +4864,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                                                 .renderData = { .rectangle = {
                                                         .backgroundColor = borderConfig->color,
                                                 } },
-                                                .userData = currentElement->config.userData,
+                                                .userData = currentElementLayoutData->userData,
                                                 .id = Clay__HashNumber(currentElement->id, currentElement->children.length + 1 + i).id,
                                                 .commandType = CLAY_RENDER_COMMAND_TYPE_RECTANGLE,
                                         });
@@ -2888,9 +4874,9 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                             }
                         }
                     }
-                    if (currentElement->config.overlayColor.a > 0) {
+                    if (currentElementLayoutData->overlayColor.a > 0) {
                         Clay_RenderCommand renderCommand = {
-                                .userData = currentElement->config.userData,
+                                .userData = currentElementLayoutData->userData,
                                 .id = currentElement->id,
                                 .zIndex = root->zIndex,
                                 .commandType = CLAY_RENDER_COMMAND_TYPE_OVERLAY_COLOR_END,
@@ -2914,30 +4900,25 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
             context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
             Clay_BoundingBox currentElementBoundingBox = { currentElementTreeNode->position.x, currentElementTreeNode->position.y, currentElement->dimensions.width, currentElement->dimensions.height };
             Clay__ScrollContainerDataInternal *scrollContainerData = CLAY__NULL;
+            Clay_ClipElementConfig *clipConfig = currentElement->isTextElement ? &Clay_ClipElementConfig_DEFAULT : Clay__GetClipConfig(currentElementLayoutData);
             if (!currentElement->isTextElement) {
-                if (useStoredBoundingBoxes && currentElement->config.transition.handler) {
-                    bool found = false;
-                    for (int j = 0; j < context->transitionDatas.length; ++j) {
-                        Clay__TransitionDataInternal* transitionData = Clay__TransitionDataInternalArray_Get(&context->transitionDatas, j);
-                        if (transitionData->elementId == currentElement->id) {
-                            found = true;
-                            if (transitionData->state != CLAY_TRANSITION_STATE_IDLE) {
-                                if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_X) != 0) currentElementBoundingBox.x = transitionData->currentState.boundingBox.x;
-                                if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_Y) != 0) currentElementBoundingBox.y = transitionData->currentState.boundingBox.y;
-                                if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_WIDTH) != 0) currentElementBoundingBox.width = transitionData->currentState.boundingBox.width;
-                                if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_HEIGHT) != 0) currentElementBoundingBox.height = transitionData->currentState.boundingBox.height;
-                            }
-                            break;
-                        }
+                Clay_TransitionElementConfig *transitionConfig = Clay__GetTransitionConfig(currentElementLayoutData);
+                Clay_FloatingElementConfig *floatingElementConfig = Clay__GetFloatingConfig(currentElementLayoutData);
+                if (useStoredBoundingBoxes && transitionConfig->handler) {
+                    Clay__TransitionDataInternal* transitionData = Clay__GetTransitionData(Clay__GetHashMapItem(currentElement->id));
+                    if (transitionData && transitionData->state != CLAY_TRANSITION_STATE_IDLE) {
+                        if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_X) != 0) currentElementBoundingBox.x = transitionData->currentState.boundingBox.x;
+                        if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_Y) != 0) currentElementBoundingBox.y = transitionData->currentState.boundingBox.y;
+                        if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_WIDTH) != 0) currentElementBoundingBox.width = transitionData->currentState.boundingBox.width;
+                        if ((transitionData->activeProperties & CLAY_TRANSITION_PROPERTY_HEIGHT) != 0) currentElementBoundingBox.height = transitionData->currentState.boundingBox.height;
                     }
                     // An exiting element that completed its transition this frame - skip tree
-                    if (!found && currentElement->config.transition.exit.setFinalState) {
+                    if (!transitionData && transitionConfig->exit.setFinalState) {
                         dfsBuffer.length--;
                         continue;
                     }
                 }
-                if (currentElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE) {
-                    Clay_FloatingElementConfig *floatingElementConfig = &currentElement->config.floating;
+                if (floatingElementConfig->attachTo != CLAY_ATTACH_TO_NONE) {
                     Clay_Dimensions expand = floatingElementConfig->expand;
                     currentElementBoundingBox.x -= expand.width;
                     currentElementBoundingBox.width += expand.width * 2;
@@ -2946,36 +4927,36 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                 }
 
                 // Apply scroll offsets to container
-                if (currentElement->config.clip.horizontal || currentElement->config.clip.vertical) {
-                    // This linear scan could theoretically be slow under very strange conditions, but I can't imagine a real UI with more than a few 10's of scroll containers
-                    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-                        if (mapping->layoutElement == currentElement) {
-                            scrollContainerData = mapping;
-                            mapping->boundingBox = currentElementBoundingBox;
-                            scrollOffset = currentElement->config.clip.childOffset;
-                            if (context->externalScrollHandlingEnabled) {
-                                scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
-                            }
-                            break;
+                if (clipConfig->horizontal || clipConfig->vertical) {
+                    Clay__ScrollContainerDataInternal *mapping = Clay__GetScrollContainerData(Clay__GetHashMapItem(currentElement->id));
+                    if (mapping && mapping->layoutElement == currentElement) {
+                        scrollContainerData = mapping;
+                        mapping->boundingBox = currentElementBoundingBox;
+                        scrollOffset = clipConfig->childOffset;
+                        if (context->externalScrollHandlingEnabled) {
+                            scrollOffset = CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
                         }
                     }
                 }
             }
 
-            bool offscreen = Clay__ElementIsOffscreen(&currentElementBoundingBox);
+            bool offscreen = currentElementTreeNode->culled || Clay__ElementIsClipped(&currentElementBoundingBox, &currentElementTreeNode->clipBoundingBox);
+            // Remembered for the upwards pass, so that closing commands are only emitted for elements that were opened
+            currentElementTreeNode->culled = offscreen;
 
             // Generate render commands for current element
             if (generateRenderCommands && !offscreen) {
                 if (currentElement->isTextElement) {
-                    Clay_TextElementConfig *textElementConfig = &currentElement->textConfig;
-                    float naturalLineHeight = currentElement->textElementData.preferredDimensions.height;
+                    Clay_TextElementConfig *textElementConfig = &currentElementLayoutData->textConfig;
+                    float naturalLineHeight = currentElementLayoutData->textElementData.preferredDimensions.height;
                     float finalLineHeight = textElementConfig->lineHeight > 0 ? (float)textElementConfig->lineHeight : naturalLineHeight;
                     float lineHeightOffset = (finalLineHeight - naturalLineHeight) / 2;
                     float yPosition = lineHeightOffset;
-                    for (int32_t lineIndex = 0; lineIndex < currentElement->textElementData.wrappedLines.length; ++lineIndex) {
-                        Clay__WrappedTextLine *wrappedLine = Clay__WrappedTextLineArraySlice_Get(&currentElement->textElementData.wrappedLines, lineIndex);
-                        if (wrappedLine->line.length == 0) {
+                    Clay_BoundingBox *textClipBoundingBox = &currentElementTreeNode->clipBoundingBox;
+                    for (int32_t lineIndex = 0; lineIndex < currentElementLayoutData->textElementData.wrappedLines.length; ++lineIndex) {
+                        Clay__WrappedTextLine *wrappedLine = Clay__WrappedTextLineArraySlice_Get(&currentElementLayoutData->textElementData.wrappedLines, lineIndex);
+                        // Skip lines that are scrolled or clipped out above the visible region
+                        if (wrappedLine->line.length == 0 || (!context->disableCulling && currentElementBoundingBox.y + yPosition + finalLineHeight < textClipBoundingBox->y)) {
                             yPosition += finalLineHeight;
                             continue;
                         }
@@ -2989,7 +4970,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                         Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
                             .boundingBox = { currentElementBoundingBox.x + offset, currentElementBoundingBox.y + yPosition, wrappedLine->dimensions.width, wrappedLine->dimensions.height },
                             .renderData = { .text = {
-                                .stringContents = CLAY__INIT(Clay_StringSlice) { .length = wrappedLine->line.length, .chars = wrappedLine->line.chars, .baseChars = currentElement->textElementData.text.chars },
+                                .stringContents = CLAY__INIT(Clay_StringSlice) { .length = wrappedLine->line.length, .chars = wrappedLine->line.chars, .baseChars = currentElementLayoutData->textElementData.text.chars },
                                 .textColor = textElementConfig->textColor,
                                 .fontId = textElementConfig->fontId,
                                 .fontSize = textElementConfig->fontSize,
@@ -3003,81 +4984,83 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                         });
                         yPosition += finalLineHeight;
 
-                        if (!context->disableCulling && (currentElementBoundingBox.y + yPosition > context->layoutDimensions.height)) {
+                        if (!context->disableCulling && (currentElementBoundingBox.y + yPosition > textClipBoundingBox->y + textClipBoundingBox->height)) {
                             break;
                         }
                     }
                 } else {
-                    if (currentElement->config.overlayColor.a > 0) {
+                    if (currentElementLayoutData->overlayColor.a > 0) {
                         Clay_RenderCommand renderCommand = {
                             .renderData = {
-                                .overlayColor = { .color = currentElement->config.overlayColor }
+                                .overlayColor = { .color = currentElementLayoutData->overlayColor }
                             },
-                            .userData = currentElement->config.userData,
+                            .userData = currentElementLayoutData->userData,
                             .id = currentElement->id,
                             .zIndex = root->zIndex,
                             .commandType = CLAY_RENDER_COMMAND_TYPE_OVERLAY_COLOR_START,
                         };
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (currentElement->config.image.imageData) {
+                    Clay_ImageElementConfig *imageConfig = Clay__GetImageConfig(currentElementLayoutData);
+                    Clay_CustomElementConfig *customConfig = Clay__GetCustomConfig(currentElementLayoutData);
+                    if (imageConfig->imageData) {
                         Clay_RenderCommand renderCommand = {
                             .boundingBox = currentElementBoundingBox,
                             .renderData = {
                                 .image = {
-                                    .backgroundColor = currentElement->config.backgroundColor,
-                                    .cornerRadius = currentElement->config.cornerRadius,
-                                    .imageData = currentElement->config.image.imageData,
+                                    .backgroundColor = currentElementLayoutData->backgroundColor,
+                                    .cornerRadius = currentElementLayoutData->cornerRadius,
+                                    .imageData = imageConfig->imageData,
                                 }
                             },
-                            .userData = currentElement->config.userData,
+                            .userData = currentElementLayoutData->userData,
                             .id = currentElement->id,
                             .zIndex = root->zIndex,
                                 .commandType = CLAY_RENDER_COMMAND_TYPE_IMAGE,
                         };
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (currentElement->config.custom.customData) {
+                    if (customConfig->customData) {
                         Clay_RenderCommand renderCommand = {
                             .boundingBox = currentElementBoundingBox,
                             .renderData = {
                                 .custom = {
-                                    .backgroundColor = currentElement->config.backgroundColor,
-                                    .cornerRadius = currentElement->config.cornerRadius,
-                                    .customData = currentElement->config.custom.customData,
+                                    .backgroundColor = currentElementLayoutData->backgroundColor,
+                                    .cornerRadius = currentElementLayoutData->cornerRadius,
+                                    .customData = customConfig->customData,
                                 }
                             },
-                            .userData = currentElement->config.userData,
+                            .userData = currentElementLayoutData->userData,
                             .id = currentElement->id,
                             .zIndex = root->zIndex,
                             .commandType = CLAY_RENDER_COMMAND_TYPE_CUSTOM,
                         };
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (currentElement->config.clip.horizontal || currentElement->config.clip.vertical) {
+                    if (clipConfig->horizontal || clipConfig->vertical) {
                         Clay_RenderCommand renderCommand = {
                             .boundingBox = currentElementBoundingBox,
                             .renderData = {
                                 .clip = {
-                                    .horizontal = currentElement->config.clip.horizontal,
-                                    .vertical = currentElement->config.clip.vertical,
+                                    .horizontal = clipConfig->horizontal,
+                                    .vertical = clipConfig->vertical,
                                 }
                             },
-                            .userData = currentElement->config.userData,
+                            .userData = currentElementLayoutData->userData,
                             .id = currentElement->id,
                             .zIndex = root->zIndex,
                             .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_START,
                         };
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (currentElement->config.backgroundColor.a > 0) {
+                    if (currentElementLayoutData->backgroundColor.a > 0) {
                         Clay_RenderCommand renderCommand = {
                             .boundingBox = currentElementBoundingBox,
                             .renderData = { .rectangle = {
-                                .backgroundColor = currentElement->config.backgroundColor,
-                                .cornerRadius = currentElement->config.cornerRadius,
+                                .backgroundColor = currentElementLayoutData->backgroundColor,
+                                .cornerRadius = currentElementLayoutData->cornerRadius,
                             } },
-                            .userData = currentElement->config.userData,
+                            .userData = currentElementLayoutData->userData,
                             .id = currentElement->id,
                             .zIndex = root->zIndex,
                             .commandType = CLAY_RENDER_COMMAND_TYPE_RECTANGLE,
@@ -3089,11 +5072,17 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
 
             Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(currentElement->id);
             hashMapItem->boundingBox = currentElementBoundingBox;
+            hashMapItem->layoutDimensions = currentElement->dimensions;
+            hashMapItem->layoutFingerprint = context->incrementalLayoutActive ? currentElement->fingerprint : 0;
 
             if (currentElement->isTextElement) continue;
 
             // Setup positions for child elements and add to DFS buffer ----------
 
+            // Children of a clip element are only visible within its bounding box, and nothing below a clip element with no visible region needs to be tested at all
+            Clay_BoundingBox childClipBoundingBox = Clay__IntersectClipBoundingBox(currentElementTreeNode->clipBoundingBox, &currentElementBoundingBox, clipConfig);
+            bool childrenCulled = !context->disableCulling && (childClipBoundingBox.width < 0 || childClipBoundingBox.height < 0);
+
             // On-axis alignment
             Clay_Dimensions contentSizeCurrent = {};
             if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
@@ -3141,7 +5130,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                 Clay_LayoutElementHashMapItem* childMapItem = Clay__GetHashMapItem(childElement->id);
                 // Alignment along non layout axis
                 if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-                    currentElementTreeNode->nextChildOffset.y = currentElement->config.layout.padding.top;
+                    currentElementTreeNode->nextChildOffset.y = currentElement->layout.padding.top;
                     float whiteSpaceAroundChild = currentElement->dimensions.height - (float)(layoutConfig->padding.top + layoutConfig->padding.bottom) - childElement->dimensions.height;
                     switch (layoutConfig->childAlignment.y) {
                         case CLAY_ALIGN_Y_TOP: break;
@@ -3149,7 +5138,7 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                         case CLAY_ALIGN_Y_BOTTOM: currentElementTreeNode->nextChildOffset.y += whiteSpaceAroundChild; break;
                     }
                 } else {
-                    currentElementTreeNode->nextChildOffset.x = currentElement->config.layout.padding.left;
+                    currentElementTreeNode->nextChildOffset.x = currentElement->layout.padding.left;
                     float whiteSpaceAroundChild = currentElement->dimensions.width - (float)(layoutConfig->padding.left + layoutConfig->padding.right) - childElement->dimensions.width;
                     switch (layoutConfig->childAlignment.x) {
                         case CLAY_ALIGN_X_LEFT: break;
@@ -3168,7 +5157,9 @@ void Clay__CalculateFinalLayout(float deltaTime, bool useStoredBoundingBoxes, bo
                 dfsBuffer.internalArray[newNodeIndex] = CLAY__INIT(Clay__LayoutElementTreeNode) {
                     .layoutElement = childElement,
                     .position = CLAY__INIT(Clay_Vector2) { childPosition.x, childPosition.y },
-                    .nextChildOffset = { .x = (float)childElement->config.layout.padding.left, .y = (float)childElement->config.layout.padding.top },
+                    .nextChildOffset = { .x = (float)childElement->layout.padding.left, .y = (float)childElement->layout.padding.top },
+                    .clipBoundingBox = childClipBoundingBox,
+                    .culled = childrenCulled,
                 };
                 context->treeNodeVisited.internalArray[newNodeIndex] = false;
 
@@ -3280,6 +5271,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
         while (dfsBuffer.length > 0) {
             int32_t currentElementIndex = Clay__int32_tArray_GetValue(&dfsBuffer, (int)dfsBuffer.length - 1);
             Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)currentElementIndex);
+            Clay__LayoutElementData *currentElementLayoutData = Clay__GetLayoutElementData(currentElement);
             if (context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
                 if (!currentElement->isTextElement && currentElement->children.length > 0) {
                     Clay__CloseElement();
@@ -3304,6 +5296,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
 
             context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
             Clay_LayoutElementHashMapItem *currentElementData = Clay__GetHashMapItem(currentElement->id);
+            Clay__LayoutElementHashMapItemCold *currentElementColdData = Clay__GetHashMapItemCold(currentElementData);
             bool offscreen = Clay__ElementIsOffscreen(&currentElementData->boundingBox);
             if (context->debugSelectedElementId == currentElement->id) {
                 layoutData.selectedElementRowIndex = layoutData.rowCount;
@@ -3316,7 +5309,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
                         .cornerRadius = CLAY_CORNER_RADIUS(4),
                         .border = { .color = CLAY__DEBUGVIEW_COLOR_3, .width = {1, 1, 1, 1, 0} },
                     }) {
-                        CLAY_TEXT((currentElementData && currentElementData->debugData.collapsed) ? CLAY_STRING("+") : CLAY_STRING("-"), CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_4, .fontSize = 16 }));
+                        CLAY_TEXT((currentElementData && currentElementColdData->debugData.collapsed) ? CLAY_STRING("+") : CLAY_STRING("-"), CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_4, .fontSize = 16 }));
                     }
                 } else { // Square dot for empty containers
                     CLAY_AUTO_ID({ .layout = { .sizing = {CLAY_SIZING_FIXED(16), CLAY_SIZING_FIXED(16)}, .childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER } } }) {
@@ -3325,7 +5318,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
                 }
                 // Collisions and offscreen info
                 if (currentElementData) {
-                    if (currentElementData->debugData.collision) {
+                    if (currentElementColdData->debugData.collision) {
                         CLAY_AUTO_ID({ .layout = { .padding = { 8, 8, 2, 2 }}, .border = { .color = {177, 147, 8, 255}, .width = {1, 1, 1, 1, 0} } }) {
                             CLAY_TEXT(CLAY_STRING("Duplicate ID"), CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_3, .fontSize = 16 }));
                         }
@@ -3336,13 +5329,13 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
                         }
                     }
                 }
-                if (currentElementData->elementId.stringId.length > 0) {
+                if (currentElementColdData->elementId.stringId.length > 0) {
                     CLAY_AUTO_ID() {
                         Clay_TextElementConfig textConfig = offscreen ? CLAY__INIT(Clay_TextElementConfig) { .textColor = CLAY__DEBUGVIEW_COLOR_3, .fontSize = 16 } : Clay__DebugView_TextNameConfig;
-                        CLAY_TEXT(currentElementData->elementId.stringId, textConfig);
-                        if (currentElementData->elementId.offset != 0) {
+                        CLAY_TEXT(currentElementColdData->elementId.stringId, textConfig);
+                        if (currentElementColdData->elementId.offset != 0) {
                             CLAY_TEXT(CLAY_STRING(" ("), textConfig);
-                            CLAY_TEXT(Clay__IntToString(currentElementData->elementId.offset), textConfig);
+                            CLAY_TEXT(Clay__IntToString(currentElementColdData->elementId.offset), textConfig);
                             CLAY_TEXT(CLAY_STRING(")"), textConfig);
                         }
                     }
@@ -3350,39 +5343,39 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
                 if (currentElement->isTextElement) {
                     Clay__RenderElementConfigTypeLabel(CLAY_STRING("Text"), CLAY__INIT(Clay_Color) { 105,210,231,255 }, offscreen);
                 } else {
-                    if (currentElement->config.backgroundColor.a > 0) {
+                    if (currentElementLayoutData->backgroundColor.a > 0) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_BACKGROUND_COLOR);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (currentElement->config.overlayColor.a > 0) {
+                    if (currentElementLayoutData->overlayColor.a > 0) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_OVERLAY_COLOR);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (!Clay__MemCmp((const char*)&currentElement->config.cornerRadius, (const char*)&Clay__CornerRadius_DEFAULT, sizeof(Clay_CornerRadius))) {
+                    if (!Clay__MemCmp((const char*)&currentElementLayoutData->cornerRadius, (const char*)&Clay__CornerRadius_DEFAULT, sizeof(Clay_CornerRadius))) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_CORNER_RADIUS);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (currentElement->config.aspectRatio.aspectRatio != 0) {
+                    if (currentElement->aspectRatio.aspectRatio != 0) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_ASPECT);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (currentElement->config.image.imageData) {
+                    if (Clay__GetImageConfig(currentElementLayoutData)->imageData) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_IMAGE);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (currentElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE) {
+                    if (Clay__GetFloatingConfig(currentElementLayoutData)->attachTo != CLAY_ATTACH_TO_NONE) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_FLOATING);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (currentElement->config.clip.horizontal || currentElement->config.clip.vertical) {
+                    if (Clay__GetClipConfig(currentElementLayoutData)->horizontal || Clay__GetClipConfig(currentElementLayoutData)->vertical) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_CLIP);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (Clay__BorderHasAnyWidth(&currentElement->config.border)) {
+                    if (Clay__BorderHasAnyWidth(Clay__GetBorderConfig(currentElementLayoutData))) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_BORDER);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
-                    if (currentElement->config.custom.customData) {
+                    if (Clay__GetCustomConfig(currentElementLayoutData)->customData) {
                         Clay__DebugElementConfigTypeLabelConfig config = Clay__DebugGetElementConfigTypeLabel(CLAY__ELEMENT_CONFIG_TYPE_CUSTOM);
                         Clay__RenderElementConfigTypeLabel(config.label, config.color, offscreen);
                     }
@@ -3392,7 +5385,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
             // Render the text contents below the element as a non-interactive row
             if (currentElement->isTextElement) {
                 layoutData.rowCount++;
-                Clay__TextElementData *textElementData = &currentElement->textElementData;
+                Clay__TextElementData *textElementData = &currentElementLayoutData->textElementData;
                 Clay_TextElementConfig rawTextConfig = offscreen ? CLAY__INIT(Clay_TextElementConfig) { .textColor = CLAY__DEBUGVIEW_COLOR_3, .fontSize = 16 } : Clay__DebugView_TextNameConfig;
                 CLAY_AUTO_ID({ .layout = { .sizing = { .height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT)}, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER } } }) {
                     CLAY_AUTO_ID({ .layout = { .sizing = {.width = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_INDENT_WIDTH + 16) } } }) {}
@@ -3413,7 +5406,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
             }
 
             layoutData.rowCount++;
-            if (!(currentElement->isTextElement || (currentElementData && currentElementData->debugData.collapsed))) {
+            if (!(currentElement->isTextElement || (currentElementData && currentElementColdData->debugData.collapsed))) {
                 for (int32_t i = currentElement->children.length - 1; i >= 0; --i) {
                     Clay__int32_tArray_Add(&dfsBuffer, currentElement->children.elements[i]);
                     context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = false; // TODO needs to be ranged checked
@@ -3427,7 +5420,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
         for (int32_t i = (int)context->pointerOverIds.length - 1; i >= 0; i--) {
             Clay_ElementId *elementId = Clay_ElementIdArray_Get(&context->pointerOverIds, i);
             if (elementId->baseId == collapseButtonId.baseId) {
-                Clay_LayoutElementHashMapItem *highlightedItem = Clay__GetHashMapItem(elementId->offset);
+                Clay__LayoutElementHashMapItemCold *highlightedItem = Clay__GetHashMapItemCold(Clay__GetHashMapItem(elementId->offset));
                 highlightedItem->debugData.collapsed = !highlightedItem->debugData.collapsed;
                 break;
             }
@@ -3540,15 +5533,12 @@ void Clay__RenderDebugView(void) {
     Clay_ElementId scrollId = Clay__HashString(CLAY_STRING("Clay__DebugViewOuterScrollPane"), 0);
     float scrollYOffset = 0;
     bool pointerInDebugView = context->pointerInfo.position.y < context->layoutDimensions.height - 300;
-    for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
-        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-        if (scrollContainerData->elementId == scrollId.id) {
-            if (!context->externalScrollHandlingEnabled) {
-                scrollYOffset = scrollContainerData->scrollPosition.y;
-            } else {
-                pointerInDebugView = context->pointerInfo.position.y + scrollContainerData->scrollPosition.y < context->layoutDimensions.height - 300;
-            }
-            break;
+    Clay__ScrollContainerDataInternal *scrollContainerData = Clay__FindScrollContainerData(scrollId.id);
+    if (scrollContainerData) {
+        if (!context->externalScrollHandlingEnabled) {
+            scrollYOffset = scrollContainerData->scrollPosition.y;
+        } else {
+            pointerInDebugView = context->pointerInfo.position.y + scrollContainerData->scrollPosition.y < context->layoutDimensions.height - 300;
         }
     }
     int32_t highlightedRow = pointerInDebugView
@@ -3587,7 +5577,9 @@ void Clay__RenderDebugView(void) {
                         layoutData = Clay__RenderDebugLayoutElementsList((int32_t)initialRootsLength, highlightedRow);
                     }
                 }
-                float contentWidth = Clay__GetHashMapItem(panelContentsId.id)->layoutElement->dimensions.width;
+                // The element list is missing if the debug view itself ran out of elements
+                Clay_LayoutElement *panelContents = Clay__GetHashMapItem(panelContentsId.id)->layoutElement;
+                float contentWidth = panelContents ? panelContents->dimensions.width : 0;
                 CLAY_AUTO_ID({ .layout = { .sizing = {.width = CLAY_SIZING_FIXED(contentWidth) }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {}
                 for (int32_t i = 0; i < layoutData.rowCount; i++) {
                     Clay_Color rowColor = (i & 1) == 0 ? CLAY__DEBUGVIEW_COLOR_2 : CLAY__DEBUGVIEW_COLOR_1;
@@ -3605,7 +5597,9 @@ void Clay__RenderDebugView(void) {
         }
         CLAY_AUTO_ID({ .layout = { .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1)} }, .backgroundColor = CLAY__DEBUGVIEW_COLOR_3 }) {}
         Clay_LayoutElementHashMapItem *selectedItem = Clay__GetHashMapItem(context->debugSelectedElementId);
+        Clay_ElementId selectedElementId = Clay__GetHashMapItemCold(selectedItem)->elementId;
         if (selectedItem->layoutElement) {
+            Clay__LayoutElementData *selectedElementData = Clay__GetLayoutElementData(selectedItem->layoutElement);
             CLAY_AUTO_ID({
                 .layout = { .sizing = {CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(300)}, .layoutDirection = CLAY_TOP_TO_BOTTOM },
                 .backgroundColor = CLAY__DEBUGVIEW_COLOR_2 ,
@@ -3615,11 +5609,11 @@ void Clay__RenderDebugView(void) {
                 CLAY_AUTO_ID({ .layout = { .sizing = {CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT + 8)}, .padding = {CLAY__DEBUGVIEW_OUTER_PADDING, CLAY__DEBUGVIEW_OUTER_PADDING, 0, 0 }, .childAlignment = {.y = CLAY_ALIGN_Y_CENTER} } }) {
                     CLAY_TEXT(CLAY_STRING("Element Configuration"), infoTextConfig);
                     CLAY_AUTO_ID({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } } }) {}
-                    if (selectedItem->elementId.stringId.length != 0) {
-                        CLAY_TEXT(selectedItem->elementId.stringId, infoTitleConfig);
-                        if (selectedItem->elementId.offset != 0) {
+                    if (selectedElementId.stringId.length != 0) {
+                        CLAY_TEXT(selectedElementId.stringId, infoTitleConfig);
+                        if (selectedElementId.offset != 0) {
                             CLAY_TEXT(CLAY_STRING(" ("), infoTitleConfig);
-                            CLAY_TEXT(Clay__IntToString(selectedItem->elementId.offset), infoTitleConfig);
+                            CLAY_TEXT(Clay__IntToString(selectedElementId.offset), infoTitleConfig);
                             CLAY_TEXT(CLAY_STRING(")"), infoTitleConfig);
                         }
                     }
@@ -3646,7 +5640,7 @@ void Clay__RenderDebugView(void) {
                     if (!selectedItem->layoutElement->isTextElement) {
                         // .layoutDirection
                         CLAY_TEXT(CLAY_STRING("Layout Direction"), infoTitleConfig);
-                        Clay_LayoutConfig *layoutConfig = &selectedItem->layoutElement->config.layout;
+                        Clay_LayoutConfig *layoutConfig = &selectedItem->layoutElement->layout;
                         CLAY_TEXT(layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM ? CLAY_STRING("TOP_TO_BOTTOM") : CLAY_STRING("LEFT_TO_RIGHT"), infoTextConfig);
                         // .sizing
                         CLAY_TEXT(CLAY_STRING("Sizing"), infoTitleConfig);
@@ -3698,9 +5692,9 @@ void Clay__RenderDebugView(void) {
                     }
                 }
                 if (selectedItem->layoutElement->isTextElement) {
-                    Clay_TextElementConfig *textConfig = &selectedItem->layoutElement->textConfig;
+                    Clay_TextElementConfig *textConfig = &selectedElementData->textConfig;
                     CLAY_AUTO_ID({ .layout = { .padding = attributeConfigPadding, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
-                        Clay__DebugViewRenderElementConfigHeader(selectedItem->elementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_TEXT);
+                        Clay__DebugViewRenderElementConfigHeader(selectedElementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_TEXT);
                         // .fontSize
                         CLAY_TEXT(CLAY_STRING("Font Size"), infoTitleConfig);
                         CLAY_TEXT(Clay__IntToString(textConfig->fontSize), infoTextConfig);
@@ -3744,25 +5738,25 @@ void Clay__RenderDebugView(void) {
                             CLAY_TEXT(CLAY_STRING("Color & Radius"), CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_4, .fontSize = 16 }));
                         }
                         // .backgroundColor
-                        if (selectedItem->layoutElement->config.backgroundColor.a > 0) {
+                        if (selectedElementData->backgroundColor.a > 0) {
                             CLAY_TEXT(CLAY_STRING("Background Color"), infoTitleConfig);
-                            Clay__RenderDebugViewColor(selectedItem->layoutElement->config.backgroundColor, infoTextConfig);
+                            Clay__RenderDebugViewColor(selectedElementData->backgroundColor, infoTextConfig);
                         }
                         // .cornerRadius
-                        if (!Clay__MemCmp((const char*)&selectedItem->layoutElement->config.cornerRadius, (const char*)&Clay__CornerRadius_DEFAULT, sizeof(Clay_CornerRadius))) {
+                        if (!Clay__MemCmp((const char*)&selectedElementData->cornerRadius, (const char*)&Clay__CornerRadius_DEFAULT, sizeof(Clay_CornerRadius))) {
                             CLAY_TEXT(CLAY_STRING("Corner Radius"), infoTitleConfig);
-                            Clay__RenderDebugViewCornerRadius(selectedItem->layoutElement->config.cornerRadius, infoTextConfig);
+                            Clay__RenderDebugViewCornerRadius(selectedElementData->cornerRadius, infoTextConfig);
                         }
                         // .overlayColor
-                        if (selectedItem->layoutElement->config.overlayColor.a > 0) {
+                        if (selectedElementData->overlayColor.a > 0) {
                             CLAY_TEXT(CLAY_STRING("Overlay Color"), infoTitleConfig);
-                            Clay__RenderDebugViewColor(selectedItem->layoutElement->config.overlayColor, infoTextConfig);
+                            Clay__RenderDebugViewColor(selectedElementData->overlayColor, infoTextConfig);
                         }
                     }
-                    if (selectedItem->layoutElement->config.aspectRatio.aspectRatio > 0) {
-                        Clay_AspectRatioElementConfig *aspectRatioConfig = &selectedItem->layoutElement->config.aspectRatio;
+                    if (selectedItem->layoutElement->aspectRatio.aspectRatio > 0) {
+                        Clay_AspectRatioElementConfig *aspectRatioConfig = &selectedItem->layoutElement->aspectRatio;
                         CLAY(CLAY_ID("Clay__DebugViewElementInfoAspectRatioBody"), { .layout = { .padding = attributeConfigPadding, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
-                            Clay__DebugViewRenderElementConfigHeader(selectedItem->elementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_ASPECT);
+                            Clay__DebugViewRenderElementConfigHeader(selectedElementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_ASPECT);
                             CLAY_TEXT(CLAY_STRING("Aspect Ratio"), infoTitleConfig);
                             // Aspect Ratio
                             CLAY(CLAY_ID("Clay__DebugViewElementInfoAspectRatio"), { }) {
@@ -3777,23 +5771,23 @@ void Clay__RenderDebugView(void) {
                             }
                         }
                     }
-                    if (selectedItem->layoutElement->config.image.imageData) {
-                        Clay_ImageElementConfig *imageConfig = &selectedItem->layoutElement->config.image;
+                    if (Clay__GetImageConfig(selectedElementData)->imageData) {
+                        Clay_ImageElementConfig *imageConfig = Clay__GetImageConfig(selectedElementData);
                         Clay_AspectRatioElementConfig aspectConfig = { 1 };
-                        if (selectedItem->layoutElement->config.aspectRatio.aspectRatio > 0) {
-                            aspectConfig = selectedItem->layoutElement->config.aspectRatio;
+                        if (selectedItem->layoutElement->aspectRatio.aspectRatio > 0) {
+                            aspectConfig = selectedItem->layoutElement->aspectRatio;
                         }
                         CLAY(CLAY_ID("Clay__DebugViewElementInfoImageBody"), { .layout = { .padding = attributeConfigPadding, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
-                            Clay__DebugViewRenderElementConfigHeader(selectedItem->elementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_IMAGE);
+                            Clay__DebugViewRenderElementConfigHeader(selectedElementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_IMAGE);
                             // Image Preview
                             CLAY_TEXT(CLAY_STRING("Preview"), infoTitleConfig);
                             CLAY_AUTO_ID({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(64, 128), .height = CLAY_SIZING_GROW(64, 128) }}, .aspectRatio = aspectConfig, .image = *imageConfig }) {}
                         }
                     }
-                    if (selectedItem->layoutElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE) {
-                        Clay_FloatingElementConfig* floatingConfig = &selectedItem->layoutElement->config.floating;
+                    if (Clay__GetFloatingConfig(selectedElementData)->attachTo != CLAY_ATTACH_TO_NONE) {
+                        Clay_FloatingElementConfig* floatingConfig = Clay__GetFloatingConfig(selectedElementData);
                         CLAY_AUTO_ID({ .layout = { .padding = attributeConfigPadding, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
-                            Clay__DebugViewRenderElementConfigHeader(selectedItem->elementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_FLOATING);
+                            Clay__DebugViewRenderElementConfigHeader(selectedElementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_FLOATING);
                             // .offset
                             CLAY_TEXT(CLAY_STRING("Offset"), infoTitleConfig);
                             CLAY_AUTO_ID({ .layout = { .layoutDirection = CLAY_LEFT_TO_RIGHT } }) {
@@ -3818,7 +5812,7 @@ void Clay__RenderDebugView(void) {
                             // .parentId
                             CLAY_TEXT(CLAY_STRING("Parent"), infoTitleConfig);
                             Clay_LayoutElementHashMapItem *hashItem = Clay__GetHashMapItem(floatingConfig->parentId);
-                            CLAY_TEXT(hashItem->elementId.stringId, infoTextConfig);
+                            CLAY_TEXT(Clay__GetHashMapItemCold(hashItem)->elementId.stringId, infoTextConfig);
                             // .attachPoints
                             CLAY_TEXT(CLAY_STRING("Attach Points"), infoTitleConfig);
                             CLAY_AUTO_ID({ .layout = { .layoutDirection = CLAY_LEFT_TO_RIGHT } }) {
@@ -3891,10 +5885,10 @@ void Clay__RenderDebugView(void) {
                             CLAY_TEXT(clipTo, infoTextConfig);
                         }
                     }
-                    Clay_ClipElementConfig *clipConfig = &selectedItem->layoutElement->config.clip;
+                    Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(selectedElementData);
                     if (clipConfig->horizontal || clipConfig->vertical) {
                         CLAY_AUTO_ID({ .layout = { .padding = attributeConfigPadding, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
-                            Clay__DebugViewRenderElementConfigHeader(selectedItem->elementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_CLIP);
+                            Clay__DebugViewRenderElementConfigHeader(selectedElementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_CLIP);
                             // .vertical
                             CLAY_TEXT(CLAY_STRING("Vertical"), infoTitleConfig);
                             CLAY_TEXT(clipConfig->vertical ? CLAY_STRING("true") : CLAY_STRING("false") , infoTextConfig);
@@ -3903,10 +5897,10 @@ void Clay__RenderDebugView(void) {
                             CLAY_TEXT(clipConfig->horizontal ? CLAY_STRING("true") : CLAY_STRING("false") , infoTextConfig);
                         }
                     }
-                    Clay_BorderElementConfig *borderConfig = &selectedItem->layoutElement->config.border;
+                    Clay_BorderElementConfig *borderConfig = Clay__GetBorderConfig(selectedElementData);
                     if (Clay__BorderHasAnyWidth(borderConfig)) {
                         CLAY(CLAY_ID("Clay__DebugViewElementInfoBorderBody"), { .layout = { .padding = attributeConfigPadding, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
-                            Clay__DebugViewRenderElementConfigHeader(selectedItem->elementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_BORDER);
+                            Clay__DebugViewRenderElementConfigHeader(selectedElementId.stringId, CLAY__ELEMENT_CONFIG_TYPE_BORDER);
                             CLAY_TEXT(CLAY_STRING("Border Widths"), infoTitleConfig);
                             CLAY_AUTO_ID({ .layout = { .layoutDirection = CLAY_LEFT_TO_RIGHT } }) {
                                 CLAY_TEXT(CLAY_STRING("{ left: "), infoTextConfig);
@@ -3975,6 +5969,7 @@ Clay__Warning *Clay__WarningArray_Add(Clay__WarningArray *array, Clay__Warning i
         array->internalArray[array->length++] = item;
         return &array->internalArray[array->length - 1];
     }
+    Clay_GetCurrentContext()->booleanWarnings.warningCapacityExceeded = true;
     return &CLAY__WARNING_DEFAULT;
 }
 
@@ -3982,6 +5977,15 @@ void* Clay__Array_Allocate_Arena(int32_t capacity, uint32_t itemSize, Clay_Arena
 {
     size_t totalSizeBytes = capacity * itemSize;
     uintptr_t nextAllocOffset = arena->nextAllocation + ((64 - (arena->nextAllocation % 64)) & 63);
+#ifdef CLAY_VIRTUAL_MEMORY
+    if (nextAllocOffset + totalSizeBytes <= arena->capacity && !Clay__CommitArena(arena, nextAllocOffset + totalSizeBytes)) {
+        Clay__currentContext->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay attempted to commit memory in its virtual memory arena, but the OS refused. Check the process memory limits."),
+                .userData = Clay__currentContext->errorHandler.userData });
+        return CLAY__NULL;
+    }
+#endif
     if (nextAllocOffset + totalSizeBytes <= arena->capacity) {
         arena->nextAllocation = nextAllocOffset + totalSizeBytes;
         return (void*)((uintptr_t)arena->memory + (uintptr_t)nextAllocOffset);
@@ -4028,6 +6032,15 @@ uint32_t Clay_MinMemorySize(void) {
     Clay_Context fakeContext = {
         .maxElementCount = Clay__defaultMaxElementCount,
         .maxMeasureTextCacheWordCount = Clay__defaultMaxMeasureTextWordCacheCount,
+        .maxElementConfigCount = Clay__defaultMaxElementConfigCount,
+        .maxScrollContainerCount = Clay__defaultMaxScrollContainerCount,
+        .maxRenderCommandCount = Clay__defaultMaxRenderCommandCount,
+        .maxWrappedTextLineCount = Clay__defaultMaxWrappedTextLineCount,
+        .maxPointerOverIdCount = Clay__defaultMaxPointerOverIdCount,
+        .maxDynamicStringDataSize = Clay__defaultMaxDynamicStringDataSize,
+        .maxTransitionCount = Clay__defaultMaxTransitionCount,
+        .maxTextMeasurementBatchSize = Clay__defaultMaxTextMeasurementBatchSize,
+        .maxPointerHitGridElementCount = Clay__defaultMaxPointerHitGridElementCount,
         .internalArena = {
             .capacity = SIZE_MAX,
             .memory = NULL,
@@ -4037,6 +6050,15 @@ uint32_t Clay_MinMemorySize(void) {
     if (currentContext) {
         fakeContext.maxElementCount = currentContext->maxElementCount;
         fakeContext.maxMeasureTextCacheWordCount = currentContext->maxMeasureTextCacheWordCount;
+        fakeContext.maxElementConfigCount = currentContext->maxElementConfigCount;
+        fakeContext.maxScrollContainerCount = currentContext->maxScrollContainerCount;
+        fakeContext.maxRenderCommandCount = currentContext->maxRenderCommandCount;
+        fakeContext.maxWrappedTextLineCount = currentContext->maxWrappedTextLineCount;
+        fakeContext.maxPointerOverIdCount = currentContext->maxPointerOverIdCount;
+        fakeContext.maxDynamicStringDataSize = currentContext->maxDynamicStringDataSize;
+        fakeContext.maxTransitionCount = currentContext->maxTransitionCount;
+        fakeContext.maxTextMeasurementBatchSize = currentContext->maxTextMeasurementBatchSize;
+        fakeContext.maxPointerHitGridElementCount = currentContext->maxPointerHitGridElementCount;
     }
     // Reserve space in the arena for the context, important for calculating min memory size correctly
     Clay__Context_Allocate_Arena(&fakeContext.internalArena);
@@ -4065,6 +6087,106 @@ void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)
     Clay__QueryScrollOffset = queryScrollOffsetFunction;
     context->queryScrollOffsetUserData = userData;
 }
+void Clay_SetLayoutTaskDispatchFunction(Clay_LayoutTaskDispatchFunction dispatchFunction, void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->layoutTaskDispatchFunction = dispatchFunction;
+    context->layoutTaskDispatchUserData = userData;
+}
+void Clay_SetMeasureTextBatchFunction(Clay_MeasureTextBatchFunction measureTextBatchFunction, void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->measureTextBatchFunction = measureTextBatchFunction;
+    context->measureTextBatchUserData = userData;
+}
+void Clay_SetArenaBlockAllocator(Clay_ArenaBlockAllocateFunction allocateFunction, Clay_ArenaBlockFreeFunction freeFunction, void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->arenaBlockAllocateFunction = allocateFunction;
+    context->arenaBlockFreeFunction = freeFunction;
+    context->arenaBlockAllocatorUserData = userData;
+}
+#endif
+
+#ifdef CLAY_VIRTUAL_MEMORY
+Clay_Arena Clay_CreateVirtualMemoryArena(size_t reserveSize, bool hugePages) {
+    size_t capacity = (reserveSize + CLAY__VIRTUAL_MEMORY_COMMIT_SIZE - 1) & ~(CLAY__VIRTUAL_MEMORY_COMMIT_SIZE - 1);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void *memory = mmap(NULL, capacity, PROT_NONE, flags, -1, 0);
+    if (capacity == 0 || memory == MAP_FAILED) {
+        return CLAY__INIT(Clay_Arena) CLAY__DEFAULT_STRUCT;
+    }
+#ifdef MADV_HUGEPAGE
+    if (hugePages) {
+        madvise(memory, capacity, MADV_HUGEPAGE);
+    }
+#endif
+    // The first step is committed straight away, which also marks the arena as one that Clay commits as it goes, see Clay__CommitArena()
+    if (mprotect(memory, CLAY__VIRTUAL_MEMORY_COMMIT_SIZE, PROT_READ | PROT_WRITE) != 0) {
+        munmap(memory, capacity);
+        return CLAY__INIT(Clay_Arena) CLAY__DEFAULT_STRUCT;
+    }
+    Clay_Arena arena = Clay_CreateArenaWithCapacityAndMemory(capacity, memory);
+    arena.committedSize = CLAY__VIRTUAL_MEMORY_COMMIT_SIZE;
+    return arena;
+}
+
+void Clay_FreeVirtualMemoryArena(Clay_Arena arena) {
+    if (arena.memory) {
+        munmap(arena.memory, arena.capacity);
+    }
+}
+
+// Returns the whole pages between two items of an array to the OS, see Clay_ReleaseUnusedEphemeralMemory()
+void Clay__ReleaseArrayItems(void *internalArray, size_t itemSize, int32_t startIndex, int32_t endIndex) {
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = ((uintptr_t)internalArray + startIndex * itemSize + pageSize - 1) & ~(pageSize - 1);
+    uintptr_t end = ((uintptr_t)internalArray + endIndex * itemSize) & ~(pageSize - 1);
+    if (end > start) {
+        madvise((void *)start, end - start, MADV_DONTNEED);
+    }
+}
+
+#define CLAY__RELEASE_UNUSED_ITEMS(array, endIndex) Clay__ReleaseArrayItems((array).internalArray, sizeof(*(array).internalArray), (array).length, (endIndex))
+
+void Clay_ReleaseUnusedEphemeralMemory(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!context) {
+        return;
+    }
+    // The copies of exiting elements and their configs are kept at the end of these arrays between frames
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElements, context->exitingElementCopyStart);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementData, context->exitingElementCopyStart);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementIdStrings, context->exitingElementCopyStart);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementChildren, context->exitingChildCopyStart);
+    CLAY__RELEASE_UNUSED_ITEMS(context->floatingConfigs, context->exitingConfigCopyStarts.floating);
+    CLAY__RELEASE_UNUSED_ITEMS(context->clipConfigs, context->exitingConfigCopyStarts.clip);
+    CLAY__RELEASE_UNUSED_ITEMS(context->borderConfigs, context->exitingConfigCopyStarts.border);
+    CLAY__RELEASE_UNUSED_ITEMS(context->transitionConfigs, context->exitingConfigCopyStarts.transition);
+    CLAY__RELEASE_UNUSED_ITEMS(context->imageConfigs, context->exitingConfigCopyStarts.image);
+    CLAY__RELEASE_UNUSED_ITEMS(context->customConfigs, context->exitingConfigCopyStarts.custom);
+    // Nothing past the end of the rest of them is used between frames
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementChildrenBuffer, context->layoutElementChildrenBuffer.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->warnings, context->warnings.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->wrappedTextLines, context->wrappedTextLines.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementTreeNodeArray1, context->layoutElementTreeNodeArray1.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementTreeRoots, context->layoutElementTreeRoots.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementTreeRootsSortBuffer, context->layoutElementTreeRootsSortBuffer.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->openLayoutElementStack, context->openLayoutElementStack.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->renderCommands, context->renderCommands.capacity);
+    // treeNodeVisited is always written before it is read, and is never deeper than the number of elements
+    Clay__ReleaseArrayItems(context->treeNodeVisited.internalArray, sizeof(bool), context->layoutElements.length, context->treeNodeVisited.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->openClipElementStack, context->openClipElementStack.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->reusableElementIndexBuffer, context->reusableElementIndexBuffer.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->layoutElementClipElementIds, context->layoutElementClipElementIds.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->pointerHitRecords, context->pointerHitRecords.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->pointerHitGridEntries, context->pointerHitGridEntries.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->dynamicStringData, context->dynamicStringData.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->pendingTextMeasurements, context->pendingTextMeasurements.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->textMeasurementRequests, context->textMeasurementRequests.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->textMeasurementTargets, context->textMeasurementTargets.capacity);
+    CLAY__RELEASE_UNUSED_ITEMS(context->textMeasurementResults, context->textMeasurementResults.capacity);
+}
 #endif
 
 CLAY_WASM_EXPORT("Clay_SetLayoutDimensions")
@@ -4074,10 +6196,174 @@ void Clay_SetLayoutDimensions(Clay_Dimensions dimensions) {
     context->layoutDimensions = dimensions;
 }
 
-CLAY_WASM_EXPORT("Clay_SetLayoutDimensions")
-Clay_Dimensions Clay_GetLayoutDimensions() {
-    Clay_Context* context = Clay_GetCurrentContext();
-    return context->layoutDimensions;
+CLAY_WASM_EXPORT("Clay_SetLayoutDimensions")
+Clay_Dimensions Clay_GetLayoutDimensions() {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->layoutDimensions;
+}
+
+void Clay__UpdatePointerState(bool isPointerDown) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (isPointerDown) {
+        if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
+            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED;
+        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_PRESSED) {
+            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
+        }
+    } else {
+        if (context->pointerInfo.state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
+            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED;
+        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_RELEASED)  {
+            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
+        }
+    }
+}
+
+// Conditionally skip mouse interactions on non-exit transitions, based on user config
+bool Clay__TransitionDisablesPointerInteractions(Clay_LayoutElement *element, Clay_LayoutElementHashMapItem *mapItem) {
+    Clay_TransitionElementConfig *transitionConfig = element->isTextElement ? &Clay_TransitionElementConfig_DEFAULT : Clay__GetTransitionConfig(Clay__GetLayoutElementData(element));
+    Clay__TransitionDataInternal* data = transitionConfig->handler ? Clay__GetTransitionData(mapItem) : CLAY__NULL;
+    if (!data) {
+        return false;
+    }
+    if (transitionConfig->interactionHandling == CLAY_TRANSITION_DISABLE_INTERACTIONS_WHILE_TRANSITIONING_POSITION) {
+        return data->state == CLAY_TRANSITION_STATE_EXITING || data->state == CLAY_TRANSITION_STATE_ENTERING || ((data->activeProperties & CLAY_TRANSITION_PROPERTY_POSITION) && data->state == CLAY_TRANSITION_STATE_TRANSITIONING);
+    } else if (transitionConfig->interactionHandling == CLAY_TRANSITION_ALLOW_INTERACTIONS_WHILE_TRANSITIONING_POSITION) {
+        return data->state == CLAY_TRANSITION_STATE_EXITING;
+    }
+    return false;
+}
+
+int32_t Clay__PointerHitGridCell(float position, float cellSize) {
+    float cell = position / cellSize;
+    if (!(cell >= 0)) {
+        return 0;
+    }
+    return cell >= CLAY__POINTER_HIT_GRID_SIZE ? CLAY__POINTER_HIT_GRID_SIZE - 1 : (int32_t)cell;
+}
+
+// The grid is rebuilt at most once per frame, so this is reported at most once per frame. It isn't a capacity that cuts the frame short,
+// so the grid is grown at the start of the next frame without dropping anything, see Clay__GrowArena().
+void Clay__PointerHitGridCapacityExceeded(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->booleanWarnings.pointerHitGridCapacityExceeded = true;
+    if (Clay__ArenaCanGrow()) {
+        return;
+    }
+    context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+        .errorType = CLAY_ERROR_TYPE_POINTER_HIT_GRID_CAPACITY_EXCEEDED,
+        .errorText = CLAY_STRING("Clay_SetPointerState() has to test every element, because the elements in the layout don't fit in its grid. Try using Clay_SetMaxPointerHitGridElementCount() with a higher value."),
+        .userData = context->errorHandler.userData });
+}
+
+// Records every element that Clay_SetPointerState would test, in the same order, and buckets them into a uniform grid over the layout by bounding box.
+// Points outside the layout fall into the edge cells, which also hold every element extending past that edge, so the grid gives the same answers everywhere.
+// If the grid runs out of space, pointer state falls back to walking the layout tree, see Clay__PointerHitGridCapacityExceeded().
+void Clay__BuildPointerHitGrid(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->pointerHitGridDirty = false;
+    context->pointerHitGridValid = false;
+    context->pointerHitRecords.length = 0;
+    if (context->layoutDimensions.width <= 0 || context->layoutDimensions.height <= 0) {
+        return;
+    }
+    Clay__int32_tArray dfsBuffer = context->layoutElementChildrenBuffer;
+    for (int32_t rootIndex = context->layoutElementTreeRoots.length - 1; rootIndex >= 0; --rootIndex) {
+        dfsBuffer.length = 0;
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        Clay_FloatingElementConfig *floatingConfig = Clay__GetFloatingConfig(Clay__GetLayoutElementData(Clay_LayoutElementArray_Get(&context->layoutElements, root->layoutElementIndex)));
+        bool rootCapturesPointer = floatingConfig->attachTo != CLAY_ATTACH_TO_NONE && floatingConfig->pointerCaptureMode == CLAY_POINTER_CAPTURE_MODE_CAPTURE;
+        Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
+        context->treeNodeVisited.internalArray[0] = false;
+        while (dfsBuffer.length > 0) {
+            if (context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
+                dfsBuffer.length--;
+                continue;
+            }
+            context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
+            Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&dfsBuffer, (int)dfsBuffer.length - 1));
+            Clay_LayoutElementHashMapItem *mapItem = Clay__GetHashMapItem(currentElement->id);
+            if (!mapItem || mapItem->generation <= context->generation) {
+                dfsBuffer.length--;
+                continue;
+            }
+            // As in Clay_SetPointerState, the rest of the tree is skipped once an element disables interactions
+            if (Clay__TransitionDisablesPointerInteractions(currentElement, mapItem)) {
+                break;
+            }
+            if (context->pointerHitRecords.length == context->pointerHitRecords.capacity) {
+                Clay__PointerHitGridCapacityExceeded();
+                return;
+            }
+            int32_t clipElementId = Clay__int32_tArray_GetValue(&context->layoutElementClipElementIds, (int32_t)(currentElement - context->layoutElements.internalArray));
+            Clay__PointerHitRecordArray_Add(&context->pointerHitRecords, CLAY__INIT(Clay__PointerHitRecord) {
+                .mapItem = mapItem,
+                .clipItem = clipElementId == 0 ? CLAY__NULL : Clay__GetHashMapItem(clipElementId),
+                .rootIndex = rootIndex,
+                .rootCapturesPointer = rootCapturesPointer,
+            });
+            for (int32_t i = currentElement->children.length - 1; i >= 0; --i) {
+                Clay__int32_tArray_Add(&dfsBuffer, currentElement->children.elements[i]);
+                context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = false;
+            }
+        }
+    }
+
+    Clay_Vector2 cellSize = { context->layoutDimensions.width / CLAY__POINTER_HIT_GRID_SIZE, context->layoutDimensions.height / CLAY__POINTER_HIT_GRID_SIZE };
+    int32_t *cellEnds = context->pointerHitGridCellStarts.internalArray;
+    for (int32_t i = 0; i < CLAY__POINTER_HIT_GRID_SIZE * CLAY__POINTER_HIT_GRID_SIZE + 1; ++i) {
+        cellEnds[i] = 0;
+    }
+    // Count the records overlapping each cell, then hand out each cell's range of entries
+    int32_t entryCount = 0;
+    for (int32_t i = 0; i < context->pointerHitRecords.length; ++i) {
+        Clay__PointerHitRecord *record = &context->pointerHitRecords.internalArray[i];
+        Clay_Vector2 pointerOffset = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, record->rootIndex)->pointerOffset;
+        Clay_BoundingBox box = record->mapItem->boundingBox;
+        box.x -= pointerOffset.x;
+        box.y -= pointerOffset.y;
+        if (box.width < 0 || box.height < 0) {
+            continue;
+        }
+        int32_t x0 = Clay__PointerHitGridCell(box.x, cellSize.x), x1 = Clay__PointerHitGridCell(box.x + box.width, cellSize.x);
+        int32_t y0 = Clay__PointerHitGridCell(box.y, cellSize.y), y1 = Clay__PointerHitGridCell(box.y + box.height, cellSize.y);
+        entryCount += (x1 - x0 + 1) * (y1 - y0 + 1);
+        if (entryCount > context->pointerHitGridEntries.capacity) {
+            Clay__PointerHitGridCapacityExceeded();
+            return;
+        }
+        for (int32_t y = y0; y <= y1; ++y) {
+            for (int32_t x = x0; x <= x1; ++x) {
+                cellEnds[y * CLAY__POINTER_HIT_GRID_SIZE + x]++;
+            }
+        }
+    }
+    for (int32_t i = 1; i < CLAY__POINTER_HIT_GRID_SIZE * CLAY__POINTER_HIT_GRID_SIZE; ++i) {
+        cellEnds[i] += cellEnds[i - 1];
+    }
+    cellEnds[CLAY__POINTER_HIT_GRID_SIZE * CLAY__POINTER_HIT_GRID_SIZE] = entryCount;
+    // Filling backwards leaves each cell's entries in visiting order, and each cell's end pointing at its start
+    for (int32_t i = context->pointerHitRecords.length - 1; i >= 0; --i) {
+        Clay__PointerHitRecord *record = &context->pointerHitRecords.internalArray[i];
+        Clay_Vector2 pointerOffset = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, record->rootIndex)->pointerOffset;
+        Clay_BoundingBox box = record->mapItem->boundingBox;
+        box.x -= pointerOffset.x;
+        box.y -= pointerOffset.y;
+        if (box.width < 0 || box.height < 0) {
+            continue;
+        }
+        int32_t x0 = Clay__PointerHitGridCell(box.x, cellSize.x), x1 = Clay__PointerHitGridCell(box.x + box.width, cellSize.x);
+        int32_t y0 = Clay__PointerHitGridCell(box.y, cellSize.y), y1 = Clay__PointerHitGridCell(box.y + box.height, cellSize.y);
+        for (int32_t y = y0; y <= y1; ++y) {
+            for (int32_t x = x0; x <= x1; ++x) {
+                context->pointerHitGridEntries.internalArray[--cellEnds[y * CLAY__POINTER_HIT_GRID_SIZE + x]] = i;
+            }
+        }
+    }
+    context->pointerHitGridEntries.length = entryCount;
+    CLAY__UPDATE_HIGH_WATER_MARK(context->memoryUsage.pointerHitGrid, context->pointerHitRecords.length);
+    context->pointerHitGridCellSize = cellSize;
+    context->pointerHitGridValid = true;
 }
 
 CLAY_WASM_EXPORT("Clay_SetPointerState")
@@ -4088,6 +6374,42 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
     }
     context->pointerInfo.position = position;
     context->pointerOverIds.length = 0;
+    if (context->pointerHitGridDirty) {
+        Clay__BuildPointerHitGrid();
+    }
+    if (context->pointerHitGridValid) {
+        int32_t cell = Clay__PointerHitGridCell(position.y, context->pointerHitGridCellSize.y) * CLAY__POINTER_HIT_GRID_SIZE + Clay__PointerHitGridCell(position.x, context->pointerHitGridCellSize.x);
+        int32_t currentRootIndex = -1;
+        bool found = false;
+        bool rootCapturesPointer = false;
+        for (int32_t i = context->pointerHitGridCellStarts.internalArray[cell]; i < context->pointerHitGridCellStarts.internalArray[cell + 1]; ++i) {
+            Clay__PointerHitRecord *record = &context->pointerHitRecords.internalArray[context->pointerHitGridEntries.internalArray[i]];
+            if (record->rootIndex != currentRootIndex) {
+                if (found && rootCapturesPointer) {
+                    break;
+                }
+                currentRootIndex = record->rootIndex;
+                found = false;
+                rootCapturesPointer = record->rootCapturesPointer;
+            }
+            Clay_LayoutElementHashMapItem *mapItem = record->mapItem;
+            Clay_Vector2 pointerOffset = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, record->rootIndex)->pointerOffset;
+            Clay_BoundingBox elementBox = mapItem->boundingBox;
+            elementBox.x -= pointerOffset.x;
+            elementBox.y -= pointerOffset.y;
+            if ((Clay__PointIsInsideRect(position, elementBox)) && (!record->clipItem || (Clay__PointIsInsideRect(position, record->clipItem->boundingBox)) || context->externalScrollHandlingEnabled)) {
+                Clay__LayoutElementHashMapItemCold *mapItemCold = Clay__GetHashMapItemCold(mapItem);
+                if (mapItemCold->onHoverFunction) {
+                    mapItemCold->onHoverFunction(mapItemCold->elementId, context->pointerInfo, mapItemCold->hoverFunctionUserData);
+                }
+                Clay__AddPointerOverId(mapItemCold->elementId);
+                found = true;
+            }
+        }
+        Clay__UpdatePointerState(isPointerDown);
+        return;
+    }
+    // Without a grid, fall back to testing every element in the layout tree
     Clay__int32_tArray dfsBuffer = context->layoutElementChildrenBuffer;
     for (int32_t rootIndex = context->layoutElementTreeRoots.length - 1; rootIndex >= 0; --rootIndex) {
         dfsBuffer.length = 0;
@@ -4109,22 +6431,8 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
             Clay_LayoutElementHashMapItem *clipItem = Clay__GetHashMapItem(clipElementId);
             // This check skips mouse interactions for elements that are currently "exit transitioning"
             if (mapItem && mapItem->generation > context->generation) {
-                // Conditionally skip mouse interactions on non-exit transitions, based on user config
-                if (!currentElement->isTextElement && currentElement->config.transition.handler) {
-                    for (int I = 0; I < context->transitionDatas.length; ++I) {
-                        Clay__TransitionDataInternal* data = Clay__TransitionDataInternalArray_Get(&context->transitionDatas, I);
-                        if (data->elementId == currentElement->id) {
-                            if (currentElement->config.transition.interactionHandling == CLAY_TRANSITION_DISABLE_INTERACTIONS_WHILE_TRANSITIONING_POSITION) {
-                                if (data->state == CLAY_TRANSITION_STATE_EXITING || data->state == CLAY_TRANSITION_STATE_ENTERING || ((data->activeProperties & CLAY_TRANSITION_PROPERTY_POSITION) && data->state == CLAY_TRANSITION_STATE_TRANSITIONING)) {
-                                    skipTree = true;
-                                }
-                            } else if (currentElement->config.transition.interactionHandling == CLAY_TRANSITION_ALLOW_INTERACTIONS_WHILE_TRANSITIONING_POSITION) {
-                                if (data->state == CLAY_TRANSITION_STATE_EXITING) {
-                                    skipTree = true;
-                                }
-                            }
-                        }
-                    }
+                if (Clay__TransitionDisablesPointerInteractions(currentElement, mapItem)) {
+                    skipTree = true;
                 }
 
                 if (skipTree) {
@@ -4137,10 +6445,11 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
                 elementBox.y -= root->pointerOffset.y;
                 if ((Clay__PointIsInsideRect(position, elementBox)) && (clipElementId == 0 || (Clay__PointIsInsideRect(position, clipItem->boundingBox)) || context->externalScrollHandlingEnabled)) {
                     if (!skipTree) {
-                        if (mapItem->onHoverFunction) {
-                            mapItem->onHoverFunction(mapItem->elementId, context->pointerInfo, mapItem->hoverFunctionUserData);
+                        Clay__LayoutElementHashMapItemCold *mapItemCold = Clay__GetHashMapItemCold(mapItem);
+                        if (mapItemCold->onHoverFunction) {
+                            mapItemCold->onHoverFunction(mapItemCold->elementId, context->pointerInfo, mapItemCold->hoverFunctionUserData);
                         }
-                        Clay_ElementIdArray_Add(&context->pointerOverIds, mapItem->elementId);
+                        Clay__AddPointerOverId(mapItemCold->elementId);
                     }
                     found = true;
                 }
@@ -4155,24 +6464,14 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
         }
 
         Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, root->layoutElementIndex);
-        if (found && rootElement->config.floating.attachTo != CLAY_ATTACH_TO_NONE && rootElement->config.floating.pointerCaptureMode == CLAY_POINTER_CAPTURE_MODE_CAPTURE) {
+        Clay__LayoutElementData *rootElementData = Clay__GetLayoutElementData(rootElement);
+        Clay_FloatingElementConfig *floatingConfig = Clay__GetFloatingConfig(rootElementData);
+        if (found && floatingConfig->attachTo != CLAY_ATTACH_TO_NONE && floatingConfig->pointerCaptureMode == CLAY_POINTER_CAPTURE_MODE_CAPTURE) {
             break;
         }
     }
 
-    if (isPointerDown) {
-        if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
-            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED;
-        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_PRESSED) {
-            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
-        }
-    } else {
-        if (context->pointerInfo.state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
-            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED;
-        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_RELEASED)  {
-            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
-        }
-    }
+    Clay__UpdatePointerState(isPointerDown);
 }
 
 CLAY_WASM_EXPORT("Clay_GetPointerState")
@@ -4193,18 +6492,39 @@ Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions
     *context = CLAY__INIT(Clay_Context) {
         .maxElementCount = oldContext ? oldContext->maxElementCount : Clay__defaultMaxElementCount,
         .maxMeasureTextCacheWordCount = oldContext ? oldContext->maxMeasureTextCacheWordCount : Clay__defaultMaxMeasureTextWordCacheCount,
+        .maxElementConfigCount = oldContext ? oldContext->maxElementConfigCount : Clay__defaultMaxElementConfigCount,
+        .maxScrollContainerCount = oldContext ? oldContext->maxScrollContainerCount : Clay__defaultMaxScrollContainerCount,
+        .maxRenderCommandCount = oldContext ? oldContext->maxRenderCommandCount : Clay__defaultMaxRenderCommandCount,
+        .maxWrappedTextLineCount = oldContext ? oldContext->maxWrappedTextLineCount : Clay__defaultMaxWrappedTextLineCount,
+        .maxPointerOverIdCount = oldContext ? oldContext->maxPointerOverIdCount : Clay__defaultMaxPointerOverIdCount,
+        .maxDynamicStringDataSize = oldContext ? oldContext->maxDynamicStringDataSize : Clay__defaultMaxDynamicStringDataSize,
+        .maxTransitionCount = oldContext ? oldContext->maxTransitionCount : Clay__defaultMaxTransitionCount,
+        .maxTextMeasurementBatchSize = oldContext ? oldContext->maxTextMeasurementBatchSize : Clay__defaultMaxTextMeasurementBatchSize,
+        .maxPointerHitGridElementCount = oldContext ? oldContext->maxPointerHitGridElementCount : Clay__defaultMaxPointerHitGridElementCount,
         .errorHandler = errorHandler.errorHandlerFunction ? errorHandler : CLAY__INIT(Clay_ErrorHandler) { Clay__ErrorHandlerFunctionDefault, 0 },
         .layoutDimensions = layoutDimensions,
         .internalArena = arena,
+        .measureTextCacheRetentionGenerations = 2,
     };
     Clay_SetCurrentContext(context);
     Clay__InitializePersistentMemory(context);
     Clay__InitializeEphemeralMemory(context);
-    for (int32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
-        context->layoutElementsHashMap.internalArray[i] = -1;
+    bool hashMapsCleared = false;
+#ifdef CLAY_VIRTUAL_MEMORY
+    // Clearing the hash maps by hand would back every page of them with physical memory straight away
+    if (arena.committedSize > 0) {
+        Clay__ZeroVirtualMemory(context->layoutElementsHashMap.internalArray, context->layoutElementsHashMap.capacity * sizeof(Clay__LayoutElementHashMapSlot));
+        Clay__ZeroVirtualMemory(context->measureTextHashMap.internalArray, context->measureTextHashMap.capacity * sizeof(int32_t));
+        hashMapsCleared = true;
     }
-    for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
-        context->measureTextHashMap.internalArray[i] = 0;
+#endif
+    if (!hashMapsCleared) {
+        for (int32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
+            context->layoutElementsHashMap.internalArray[i] = CLAY__INIT(Clay__LayoutElementHashMapSlot) CLAY__DEFAULT_STRUCT;
+        }
+        for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
+            context->measureTextHashMap.internalArray[i] = 0;
+        }
     }
     context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
     context->layoutDimensions = layoutDimensions;
@@ -4228,33 +6548,75 @@ Clay_Vector2 Clay_GetScrollOffset(void) {
         return CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-        if (mapping->layoutElement == openLayoutElement) {
-            return mapping->scrollPosition;
-        }
+    Clay__ScrollContainerDataInternal *mapping = Clay__FindScrollContainerData(openLayoutElement->id);
+    if (mapping && mapping->layoutElement == openLayoutElement) {
+        return mapping->scrollPosition;
     }
     return CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
 }
 
+CLAY_WASM_EXPORT("Clay_GetVirtualListRange")
+Clay_VirtualListRange Clay_GetVirtualListRange(Clay_VirtualListConfig config) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_VirtualListRange range = { .startIndex = 0, .endIndex = CLAY__MAX(config.itemCount, 0) };
+    float stride = config.itemSize;
+    if (context->booleanWarnings.maxElementsExceeded || config.itemCount <= 0) {
+        return range;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    bool xAxis = openLayoutElement->layout.layoutDirection == CLAY_LEFT_TO_RIGHT;
+    float childGap = (float)openLayoutElement->layout.childGap;
+    stride += childGap;
+    if (stride <= 0) {
+        return range;
+    }
+    Clay_Vector2 scrollPosition = CLAY__DEFAULT_STRUCT;
+    // Before the container has been laid out once, assume it could be as large as the whole layout
+    Clay_Dimensions viewportSize = context->layoutDimensions;
+    Clay__ScrollContainerDataInternal *mapping = Clay__FindScrollContainerData(openLayoutElement->id);
+    if (mapping && mapping->layoutElement == openLayoutElement) {
+        scrollPosition = mapping->scrollPosition;
+        if (mapping->boundingBox.width > 0 && mapping->boundingBox.height > 0) {
+            viewportSize = CLAY__INIT(Clay_Dimensions) { mapping->boundingBox.width, mapping->boundingBox.height };
+        }
+    }
+    float visibleStart = xAxis
+        ? -scrollPosition.x - (float)openLayoutElement->layout.padding.left
+        : -scrollPosition.y - (float)openLayoutElement->layout.padding.top;
+    float visibleEnd = visibleStart + (xAxis ? viewportSize.width : viewportSize.height);
+    float startIndex = visibleStart / stride - (float)config.overscanCount;
+    float endIndex = visibleEnd / stride + (float)config.overscanCount + 1;
+    range.startIndex = startIndex <= 0 ? 0 : (int32_t)CLAY__MIN(startIndex, (float)config.itemCount);
+    range.endIndex = endIndex <= 0 ? 0 : (int32_t)CLAY__MIN(endIndex, (float)config.itemCount);
+    range.endIndex = CLAY__MAX(range.endIndex, range.startIndex);
+    // The gap between a spacer and its neighbouring item is added by the layout, so it is left out of the spacer
+    if (range.startIndex > 0) {
+        range.leadingSpace = CLAY__MAX((float)range.startIndex * stride - childGap, 0);
+    }
+    if (range.endIndex < config.itemCount) {
+        range.trailingSpace = CLAY__MAX((float)(config.itemCount - range.endIndex) * stride - childGap, 0);
+    }
+    return range;
+}
+
 CLAY_WASM_EXPORT("Clay_UpdateScrollContainers")
 void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDelta, float deltaTime) {
     Clay_Context* context = Clay_GetCurrentContext();
     bool isPointerActive = enableDragScrolling && (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED || context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME);
-    // Don't apply scroll events to ancestors of the inner element
-    int32_t highestPriorityElementIndex = -1;
-    Clay__ScrollContainerDataInternal *highestPriorityScrollData = CLAY__NULL;
     for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
         Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+        // Removal moves the last scroll data into this slot, so it needs to be visited again
         if (!scrollData->openThisFrame) {
-            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, i);
+            Clay__RemoveScrollContainerData(i);
+            i--;
             continue;
         }
         scrollData->openThisFrame = false;
         Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(scrollData->elementId);
         // Element isn't rendered this frame but scroll offset has been retained
-        if (!hashMapItem) {
-            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, i);
+        if (hashMapItem == &Clay_LayoutElementHashMapItem_DEFAULT) {
+            Clay__RemoveScrollContainerData(i);
+            i--;
             continue;
         }
 
@@ -4290,18 +6652,18 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
             scrollData->scrollMomentum.y = 0;
         }
         scrollData->scrollPosition.y = CLAY__MIN(CLAY__MAX(scrollData->scrollPosition.y, -(CLAY__MAX(scrollData->contentSize.height - scrollData->layoutElement->dimensions.height, 0))), 0);
+    }
 
-        for (int32_t j = 0; j < context->pointerOverIds.length; ++j) { // TODO n & m are small here but this being n*m gives me the creeps
-            if (scrollData->layoutElement->id == Clay_ElementIdArray_Get(&context->pointerOverIds, j)->id) {
-                highestPriorityElementIndex = j;
-                highestPriorityScrollData = scrollData;
-            }
-        }
+    // Don't apply scroll events to ancestors of the inner element.
+    // Children are hit tested after their parents, so the innermost scroll container is the last one in pointerOverIds.
+    Clay__ScrollContainerDataInternal *highestPriorityScrollData = CLAY__NULL;
+    for (int32_t j = context->pointerOverIds.length - 1; j >= 0 && !highestPriorityScrollData; --j) {
+        highestPriorityScrollData = Clay__GetScrollContainerData(Clay__GetHashMapItem(Clay_ElementIdArray_Get(&context->pointerOverIds, j)->id));
     }
 
-    if (highestPriorityElementIndex > -1 && highestPriorityScrollData) {
+    if (highestPriorityScrollData) {
         Clay_LayoutElement *scrollElement = highestPriorityScrollData->layoutElement;
-        Clay_ClipElementConfig *clipConfig = &scrollElement->config.clip;
+        Clay_ClipElementConfig *clipConfig = Clay__GetClipConfig(Clay__GetLayoutElementData(scrollElement));
         bool canScrollVertically = clipConfig->vertical && highestPriorityScrollData->contentSize.height > scrollElement->dimensions.height;
         bool canScrollHorizontally = clipConfig->horizontal && highestPriorityScrollData->contentSize.width > scrollElement->dimensions.width;
         // Handle wheel scroll
@@ -4351,37 +6713,78 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
     }
 }
 
+// Combines the hash of this frame's declarations with the other inputs that affect layout and rendering
+uint64_t Clay__CalculateFrameHash(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__AddToDeclarationHash(Clay__HashData((const uint8_t *)&context->layoutDimensions, sizeof(Clay_Dimensions)));
+    Clay__AddToDeclarationHash(Clay__HashData((const uint8_t *)&context->pointerInfo, sizeof(Clay_PointerData)));
+    Clay__AddToDeclarationHash((uint64_t)context->maxElementCount);
+    // The previous frame's render commands are reused in place, so they must still be at the same address and fit in the array
+    Clay__AddToDeclarationHash((uintptr_t)context->renderCommands.internalArray);
+    Clay__AddToDeclarationHash((uint64_t)context->renderCommands.capacity);
+    Clay__AddToDeclarationHash(context->disableCulling);
+    Clay__AddToDeclarationHash(context->layoutFingerprintSeed);
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
+        Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+        Clay__AddToDeclarationHash(scrollData->elementId);
+        Clay__AddToDeclarationHash(Clay__HashData((const uint8_t *)&scrollData->scrollPosition, sizeof(Clay_Vector2)));
+    }
+    return context->declarationHash == 0 ? 1 : context->declarationHash; // Reserve zero as "can't be reused"
+}
+
 CLAY_WASM_EXPORT("Clay_BeginLayout")
 void Clay_BeginLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
+    if (context->arenaBlockAllocateFunction) {
+        Clay__GrowArena(context);
+    } else if (context->arenaGrowthRequested) {
+        // A capacity setter was called, so the ephemeral arrays are laid out again from the new capacities below,
+        // and the render commands of the previous frame are no longer where they were
+        context->arenaGrowthRequested = false;
+        context->previousDeclarationHash = 0;
+    }
     Clay__InitializeEphemeralMemory(context);
     context->generation++;
+    Clay__SweepMeasureTextCache();
+    context->pointerHitGridDirty = false;
+    context->pointerHitGridValid = false;
     context->dynamicElementIndex = 0;
+    context->declarationHash = 0;
     // Set up the root container that covers the entire window
     Clay_Dimensions rootDimensions = {context->layoutDimensions.width, context->layoutDimensions.height};
     if (context->debugModeEnabled) {
         rootDimensions.width -= (float)Clay__debugViewWidth;
     }
     context->booleanWarnings = CLAY__INIT(Clay_BooleanWarnings) CLAY__DEFAULT_STRUCT;
+    context->droppedElementCount = 0;
     Clay__OpenElementWithId(CLAY_ID("Clay__RootContainer"));
     Clay__ConfigureOpenElement(CLAY__INIT(Clay_ElementDeclaration) {
         .layout = { .sizing = {CLAY_SIZING_FIXED((rootDimensions.width)), CLAY_SIZING_FIXED(rootDimensions.height)} }
     });
     Clay__int32_tArray_Add(&context->openLayoutElementStack, 0);
     Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) { .layoutElementIndex = 0 });
+    context->textMeasurementDeferred = true;
 }
 
 void Clay__CloneElementsWithExitTransition() {
     Clay_Context* context = Clay_GetCurrentContext();
     int32_t nextIndex = context->layoutElements.capacity - 1;
     int32_t nextChildIndex = context->layoutElementChildren.capacity - 1;
+    Clay__ElementConfigIndices nextConfigIndices = {
+        context->floatingConfigs.capacity - 1,
+        context->clipConfigs.capacity - 1,
+        context->borderConfigs.capacity - 1,
+        context->transitionConfigs.capacity - 1,
+        context->imageConfigs.capacity - 1,
+        context->customConfigs.capacity - 1,
+    };
 
     for (int i = 0; i < context->transitionDatas.length; ++i) {
         Clay__TransitionDataInternal *data = Clay__TransitionDataInternalArray_Get(&context->transitionDatas, i);
-        Clay_TransitionElementConfig* config = &data->elementThisFrame->config.transition;
         if (data->transitionOut) {
             Clay__int32_tArray bfsBuffer = context->openLayoutElementStack;
             bfsBuffer.length = 0;
+            Clay__CopyElementConfigs(Clay__LayoutElementDataArray_Set_DontTouchLength(&context->layoutElementData, nextIndex, *Clay__GetLayoutElementData(data->elementThisFrame)), &nextConfigIndices);
             Clay_LayoutElement* newElement = Clay_LayoutElementArray_Set_DontTouchLength(&context->layoutElements, nextIndex, *data->elementThisFrame);
             Clay__StringArray_Set_DontTouchLength(&context->layoutElementIdStrings, nextIndex, *Clay__StringArray_GetCheckCapacity(&context->layoutElementIdStrings, data->elementThisFrame - context->layoutElements.internalArray));
             Clay__int32_tArray_Add(&bfsBuffer, nextIndex);
@@ -4395,6 +6798,10 @@ void Clay__CloneElementsWithExitTransition() {
                 for (int j = layoutElement->children.length - 1; j >= 0; --j) {
                     Clay_LayoutElement* childElement = Clay_LayoutElementArray_GetCheckCapacity(&context->layoutElements, layoutElement->children.elements[j]);
                     Clay__int32_tArray_Add(&bfsBuffer, nextIndex);
+                    Clay__LayoutElementData* newChildElementData = Clay__LayoutElementDataArray_Set_DontTouchLength(&context->layoutElementData, nextIndex, *Clay__GetLayoutElementData(childElement));
+                    if (!childElement->isTextElement) {
+                        Clay__CopyElementConfigs(newChildElementData, &nextConfigIndices);
+                    }
                     Clay_LayoutElement* newChildElement = Clay_LayoutElementArray_Set_DontTouchLength(&context->layoutElements, nextIndex, *childElement);
                     Clay__StringArray_Set_DontTouchLength(&context->layoutElementIdStrings, nextIndex, *Clay__StringArray_GetCheckCapacity(&context->layoutElementIdStrings, childElement - context->layoutElements.internalArray));
                     Clay__int32_tArray_Set_DontTouchLength(&context->layoutElementChildren, nextChildIndex, nextIndex);
@@ -4405,13 +6812,24 @@ void Clay__CloneElementsWithExitTransition() {
             }
         }
     }
+    context->exitingElementCopyStart = nextIndex + 1;
+    context->exitingChildCopyStart = nextChildIndex + 1;
+    context->exitingConfigCopyStarts = CLAY__INIT(Clay__ElementConfigIndices) {
+        nextConfigIndices.floating + 1,
+        nextConfigIndices.clip + 1,
+        nextConfigIndices.border + 1,
+        nextConfigIndices.transition + 1,
+        nextConfigIndices.image + 1,
+        nextConfigIndices.custom + 1,
+    };
 };
 
 void Clay_ApplyTransitionedPropertiesToElement(Clay_LayoutElement* currentElement, Clay_TransitionProperty properties, Clay_TransitionData currentTransitionData, Clay_BoundingBox* boundingBox, bool reparented) {
+    Clay__LayoutElementData *elementData = Clay__GetLayoutElementData(currentElement);
     if (properties & CLAY_TRANSITION_PROPERTY_WIDTH) {
         if (!reparented) {
             currentElement->dimensions.width = currentTransitionData.boundingBox.width;
-            currentElement->config.layout.sizing.width = CLAY_SIZING_FIXED(currentTransitionData.boundingBox.width);
+            currentElement->layout.sizing.width = CLAY_SIZING_FIXED(currentTransitionData.boundingBox.width);
         } else {
             boundingBox->width = currentTransitionData.boundingBox.width;
         }
@@ -4419,7 +6837,7 @@ void Clay_ApplyTransitionedPropertiesToElement(Clay_LayoutElement* currentElemen
     if (properties & CLAY_TRANSITION_PROPERTY_HEIGHT) {
         if (!reparented) {
             currentElement->dimensions.height = currentTransitionData.boundingBox.height;
-            currentElement->config.layout.sizing.height = CLAY_SIZING_FIXED(currentTransitionData.boundingBox.height);
+            currentElement->layout.sizing.height = CLAY_SIZING_FIXED(currentTransitionData.boundingBox.height);
         } else {
             boundingBox->height = currentTransitionData.boundingBox.height;
         }
@@ -4431,32 +6849,69 @@ void Clay_ApplyTransitionedPropertiesToElement(Clay_LayoutElement* currentElemen
         boundingBox->y = currentTransitionData.boundingBox.y;
     }
     if (properties & CLAY_TRANSITION_PROPERTY_OVERLAY_COLOR) {
-        currentElement->config.overlayColor = currentTransitionData.overlayColor;
+        elementData->overlayColor = currentTransitionData.overlayColor;
     }
     if (properties & CLAY_TRANSITION_PROPERTY_BACKGROUND_COLOR) {
-        currentElement->config.backgroundColor = currentTransitionData.backgroundColor;
+        elementData->backgroundColor = currentTransitionData.backgroundColor;
     }
-    if (properties & CLAY_TRANSITION_PROPERTY_BORDER_COLOR) {
-        currentElement->config.border.color = currentTransitionData.borderColor;
-    }
-    if (properties & CLAY_TRANSITION_PROPERTY_BORDER_WIDTH) {
-        currentElement->config.border.width = currentTransitionData.borderWidth;
+    if (properties & (CLAY_TRANSITION_PROPERTY_BORDER_COLOR | CLAY_TRANSITION_PROPERTY_BORDER_WIDTH)) {
+        Clay_BorderElementConfig *borderConfig = Clay__AddBorderConfig(elementData);
+        if (borderConfig) {
+            if (properties & CLAY_TRANSITION_PROPERTY_BORDER_COLOR) {
+                borderConfig->color = currentTransitionData.borderColor;
+            }
+            if (properties & CLAY_TRANSITION_PROPERTY_BORDER_WIDTH) {
+                borderConfig->width = currentTransitionData.borderWidth;
+            }
+        }
     }
 }
 
+// Called at the end of each frame, when the per frame arrays are at their fullest, see Clay_GetMemoryUsage()
+void Clay__UpdateMemoryHighWaterMarks(Clay_Context *context) {
+    Clay_MemoryUsage *usage = &context->memoryUsage;
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->elements, context->layoutElements.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->elementIds, context->layoutElementsHashMapLiveList.length);
+    // Slot zero of each config pool isn't used
+    int32_t configCount = CLAY__MAX(CLAY__MAX(context->floatingConfigs.length, context->clipConfigs.length), CLAY__MAX(context->borderConfigs.length, context->transitionConfigs.length));
+    configCount = CLAY__MAX(configCount, CLAY__MAX(context->imageConfigs.length, context->customConfigs.length));
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->elementConfigs, CLAY__MAX(configCount, context->layoutElementTreeRoots.length) - 1);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->renderCommands, context->renderCommands.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->wrappedTextLines, context->wrappedTextLines.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->pointerOverIds, context->pointerOverIds.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->dynamicStringData, context->dynamicStringData.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->scrollContainers, context->scrollContainerDatas.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->transitions, context->transitionDatas.length);
+    // Slot zero of the text measurement cache isn't used either
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->measureTextCacheItems, context->measureTextHashMapInternal.length - 1 - context->measureTextHashMapInternalFreeList.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->measuredWords, context->measuredWords.length);
+    CLAY__UPDATE_HIGH_WATER_MARK(usage->warnings, context->warnings.length);
+}
+
 CLAY_WASM_EXPORT("Clay_EndLayout")
 Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__CloseElement();
+    // The debug view reads the sizes of its elements while declaring them, so text declared from here on is measured straight away
+    context->textMeasurementDeferred = false;
+    uint64_t frameHash = 0;
+    if (context->frameReuseEnabled && !context->debugModeEnabled) {
+        frameHash = Clay__CalculateFrameHash();
+    }
 
-    for (int i = 0; i < context->transitionDatas.length; ++i) {
+    // When the frame ran out of elements, the ones that were dropped would look like they had been removed, and the elements that
+    // transitions point to may not have been declared this frame, so transitions are left as they are until the next frame
+    for (int i = 0; i < context->transitionDatas.length && !context->booleanWarnings.maxElementsExceeded; ++i) {
         Clay__TransitionDataInternal *data = Clay__TransitionDataInternalArray_Get(&context->transitionDatas, i);
         Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(data->elementId);
         // This might seems strange - can't we just look up the element itself, and check the config to see whether it has an exit transition defined?
         // That would work fine if the element actually had an exit transition in the first place. If it doesn't have an exit transition defined, the element
         // will have simply disappeared completely at this point, and there will be no element through which to access the config.
-        if (data->transitionOut) {
-            Clay_TransitionElementConfig* config = &data->elementThisFrame->config.transition;
+        // If the element's transition config was dropped because its config pool was full, the transition data is deleted below.
+        Clay_LayoutElement *transitionElement = hashMapItem->generation > context->generation ? hashMapItem->layoutElement : data->elementThisFrame;
+        if (data->transitionOut && Clay__GetTransitionConfig(Clay__GetLayoutElementData(transitionElement))->handler) {
+            Clay__LayoutElementData* elementData = Clay__GetLayoutElementData(data->elementThisFrame);
+            Clay_TransitionElementConfig* config = Clay__GetTransitionConfig(elementData);
             // Element wasn't found this frame - either delete transition data or transition out
             if (hashMapItem->generation <= context->generation) {
                 Clay_LayoutElementHashMapItem *parentHashMapItem = Clay__GetHashMapItem(data->parentId);
@@ -4464,18 +6919,22 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                 if (config->exit.trigger == CLAY_TRANSITION_EXIT_TRIGGER_WHEN_PARENT_EXITS || !parentHashMapItem || parentHashMapItem->generation > context->generation) {
                     // This if only runs one single time when the element first starts exiting
                     if (data->state != CLAY_TRANSITION_STATE_EXITING) {
-                        if (parentHashMapItem->generation <= context->generation) {
-                            data->elementThisFrame->config.floating.attachTo = CLAY_ATTACH_TO_ROOT;
-                            data->elementThisFrame->config.floating.offset = CLAY__INIT(Clay_Vector2) { hashMapItem->boundingBox.x, hashMapItem->boundingBox.y };
-                            data->elementThisFrame->config.floating.parentId = Clay__HashString(CLAY_STRING("Clay__RootContainer"), 0).id;
+                        Clay_FloatingElementConfig* floatingConfig = parentHashMapItem->generation <= context->generation ? Clay__AddFloatingConfig(elementData) : NULL;
+                        if (floatingConfig) {
+                            floatingConfig->attachTo = CLAY_ATTACH_TO_ROOT;
+                            floatingConfig->offset = CLAY__INIT(Clay_Vector2) { hashMapItem->boundingBox.x, hashMapItem->boundingBox.y };
+                            floatingConfig->parentId = Clay__HashString(CLAY_STRING("Clay__RootContainer"), 0).id;
                         }
                         data->elementThisFrame->exiting = true;
-                        data->elementThisFrame->config.layout.sizing.width = CLAY_SIZING_FIXED(data->elementThisFrame->dimensions.width);
-                        data->elementThisFrame->config.layout.sizing.height = CLAY_SIZING_FIXED(data->elementThisFrame->dimensions.height);
+                        data->elementThisFrame->layout.sizing.width = CLAY_SIZING_FIXED(data->elementThisFrame->dimensions.width);
+                        data->elementThisFrame->layout.sizing.height = CLAY_SIZING_FIXED(data->elementThisFrame->dimensions.height);
                         data->state = CLAY_TRANSITION_STATE_EXITING;
                         data->activeProperties = config->properties;
                         data->elapsedTime = 0;
-                        data->targetState = config->exit.setFinalState(data->targetState, config->properties);
+                        // After a frame that ran out of configs the element's transition config may be the default one
+                        if (config->exit.setFinalState) {
+                            data->targetState = config->exit.setFinalState(data->targetState, config->properties);
+                        }
                     }
 
                     // Below this line runs every frame while element is exiting -----------
@@ -4483,6 +6942,8 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                     // Clone the entire subtree back into the main UI layout tree
                     Clay__int32_tArray bfsBuffer = context->openLayoutElementStack;
                     bfsBuffer.length = 0;
+                    // The copied configs may be stored beyond the end of their pools, see Clay__CloneElementsWithExitTransition()
+                    Clay__CopyElementConfigs(Clay__LayoutElementDataArray_Add(&context->layoutElementData, *elementData), NULL);
                     data->elementThisFrame = Clay_LayoutElementArray_Add(&context->layoutElements, *data->elementThisFrame);
                     int32_t exitingElementIndex = data->elementThisFrame - context->layoutElements.internalArray;
                     Clay__StringArray_Add(&context->layoutElementIdStrings, *Clay__StringArray_GetCheckCapacity(&context->layoutElementIdStrings, exitingElementIndex));
@@ -4498,12 +6959,15 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                         for (int j = 0; j < layoutElement->children.length; ++j) {
                             Clay_LayoutElement* childElement = Clay_LayoutElementArray_GetCheckCapacity(&context->layoutElements, layoutElement->children.elements[j]);
                             int32_t childElementIndex = childElement - context->layoutElements.internalArray;
+                            Clay__LayoutElementData* newChildElementData = Clay__LayoutElementDataArray_Add(&context->layoutElementData, *Clay__GetLayoutElementData(childElement));
                             Clay_LayoutElement* newChildElement = Clay_LayoutElementArray_Add(&context->layoutElements, *childElement);
                             Clay__StringArray_Add(&context->layoutElementIdStrings, *Clay__StringArray_GetCheckCapacity(&context->layoutElementIdStrings, childElementIndex));
                             Clay__int32_tArray_Add(&context->layoutElementClipElementIds, *Clay__int32_tArray_GetCheckCapacity(&context->layoutElementClipElementIds, childElementIndex));
                             Clay__int32_tArray_Add(&bfsBuffer, context->layoutElements.length - 1);
                             if (newChildElement->isTextElement) {
-                                newChildElement->textElementData.wrappedLines.length = 0;
+                                newChildElementData->textElementData.wrappedLines.length = 0;
+                            } else {
+                                Clay__CopyElementConfigs(newChildElementData, NULL);
                             }
                             Clay__int32_tArray_Add(&context->layoutElementChildren, context->layoutElements.length - 1);
                         }
@@ -4512,9 +6976,21 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
 
                     // Reattach the inserted subtree to its previous parent if it still exists
                     // and the exiting element is not floating
-                    Clay_FloatingElementConfig* floatingConfig = &hashMapItem->layoutElement->config.floating;
+                    Clay_FloatingElementConfig* floatingConfig = Clay__GetFloatingConfig(Clay__GetLayoutElementData(hashMapItem->layoutElement));
                     if (parentHashMapItem->generation > context->generation && floatingConfig->attachTo == CLAY_ATTACH_TO_NONE) {
                         Clay_LayoutElement *parentElement = parentHashMapItem->layoutElement;
+                        // Every exiting sibling makes its own copy of the parent's children, which can run out of space when many exit at once
+                        if (context->layoutElementChildren.length + parentElement->children.length + 1 > context->layoutElementChildren.capacity) {
+                            if (!context->booleanWarnings.maxElementsExceeded && Clay__CapacityExceeded()) {
+                                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                                    .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+                                    .errorText = CLAY_STRING("Clay ran out of capacity while reattaching exiting elements. Try using Clay_SetMaxElementCount() with a higher value."),
+                                    .userData = context->errorHandler.userData });
+                            }
+                            context->booleanWarnings.maxElementsExceeded = true;
+                            context->booleanWarnings.childrenCapacityExceeded = true;
+                            continue;
+                        }
                         int32_t newChildrenStartIndex = context->layoutElementChildren.length;
                         bool found = false;
                         if (config->exit.siblingOrdering == CLAY_EXIT_TRANSITION_ORDERING_UNDERNEATH_SIBLINGS) {
@@ -4534,7 +7010,8 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                         parentElement->children.length++;
                         parentElement->children.elements = &context->layoutElementChildren.internalArray[newChildrenStartIndex];
                     // Otherwise, create the tree root for the floating element (needs to be created every frame)
-                    } else {
+                    // If its floating config couldn't be stored, there may not be a tree root left for it
+                    } else if (context->layoutElementTreeRoots.length < context->layoutElementTreeRoots.capacity) {
                         Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) {
                             .layoutElementIndex = (int32_t)(data->elementThisFrame - context->layoutElements.internalArray),
                             .parentId = floatingConfig->parentId,
@@ -4543,15 +7020,15 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                     }
                 // Parent exited, just delete child without exit transition
                 } else {
-                    Clay__TransitionDataInternalArray_RemoveSwapback(&context->transitionDatas, i);
+                    Clay__RemoveTransitionData(i);
                     i--;
                     continue;
                 }
             }
         // Transition element exited and doesn't have an exit handler defined
         // Or, the user deleted the transition handler from one frame to the next
-        } else if (hashMapItem->generation <= context->generation || !hashMapItem->layoutElement->config.transition.handler) {
-            Clay__TransitionDataInternalArray_RemoveSwapback(&context->transitionDatas, i);
+        } else if (hashMapItem->generation <= context->generation || !Clay__GetTransitionConfig(Clay__GetLayoutElementData(hashMapItem->layoutElement))->handler) {
+            Clay__RemoveTransitionData(i);
             i--;
             continue;
         }
@@ -4572,41 +7049,44 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
             for (int i = 0; i < context->transitionDatas.length; ++i) {
                 Clay__TransitionDataInternal* transitionData = Clay__TransitionDataInternalArray_Get(&context->transitionDatas, i);
                 Clay_LayoutElement* currentElement = transitionData->elementThisFrame;
+                Clay__LayoutElementData* elementData = Clay__GetLayoutElementData(currentElement);
+                Clay_TransitionElementConfig* transitionConfig = Clay__GetTransitionConfig(elementData);
+                Clay_BorderElementConfig* borderConfig = Clay__GetBorderConfig(elementData);
                 Clay_LayoutElementHashMapItem* mapItem = Clay__GetHashMapItem(transitionData->elementId);
                 Clay_LayoutElementHashMapItem* parentMapItem = Clay__GetHashMapItem(transitionData->parentId);
                 Clay_TransitionData targetState = transitionData->targetState;
                 if (transitionData->state != CLAY_TRANSITION_STATE_EXITING) {
                     targetState = CLAY__INIT(Clay_TransitionData) {
                             mapItem->boundingBox,
-                            currentElement->config.backgroundColor,
-                            currentElement->config.overlayColor,
-                            currentElement->config.border.color,
-                            currentElement->config.border.width,
+                            elementData->backgroundColor,
+                            elementData->overlayColor,
+                            borderConfig->color,
+                            borderConfig->width,
                     };
                 }
                 Clay_TransitionData oldTargetState = transitionData->targetState;
                 transitionData->targetState = targetState;
                 if (mapItem->appearedThisFrame) {
-                    if (currentElement->config.transition.enter.setInitialState && !(parentMapItem->appearedThisFrame && currentElement->config.transition.enter.trigger == CLAY_TRANSITION_ENTER_SKIP_ON_FIRST_PARENT_FRAME)) {
+                    if (transitionConfig->enter.setInitialState && !(parentMapItem->appearedThisFrame && transitionConfig->enter.trigger == CLAY_TRANSITION_ENTER_SKIP_ON_FIRST_PARENT_FRAME)) {
                         transitionData->state = CLAY_TRANSITION_STATE_ENTERING;
-                        transitionData->initialState = currentElement->config.transition.enter.setInitialState(transitionData->targetState, currentElement->config.transition.properties);
+                        transitionData->initialState = transitionConfig->enter.setInitialState(transitionData->targetState, transitionConfig->properties);
                         transitionData->currentState = transitionData->initialState;
-                        transitionData->activeProperties = currentElement->config.transition.properties;
-                        Clay_ApplyTransitionedPropertiesToElement(currentElement, currentElement->config.transition.properties, transitionData->initialState, &mapItem->boundingBox, transitionData->reparented);
+                        transitionData->activeProperties = transitionConfig->properties;
+                        Clay_ApplyTransitionedPropertiesToElement(currentElement, transitionConfig->properties, transitionData->initialState, &mapItem->boundingBox, transitionData->reparented);
                     } else {
                         transitionData->initialState = targetState;
                         transitionData->currentState = targetState;
                         transitionData->activeProperties = CLAY_TRANSITION_PROPERTY_NONE;
                     }
                 } else {
-                    Clay_Vector2 parentScrollOffset = parentMapItem->layoutElement->config.clip.childOffset;
+                    Clay_Vector2 parentScrollOffset = Clay__GetClipConfig(Clay__GetLayoutElementData(parentMapItem->layoutElement))->childOffset;
                     Clay_Vector2 newRelativePosition = {
                         mapItem->boundingBox.x - parentMapItem->boundingBox.x - parentScrollOffset.x,
                         mapItem->boundingBox.y - parentMapItem->boundingBox.y - parentScrollOffset.y,
                     };
                     Clay_Vector2 oldRelativePosition = transitionData->oldParentRelativePosition;
                     transitionData->oldParentRelativePosition = newRelativePosition;
-                    Clay_TransitionProperty properties = currentElement->config.transition.properties;
+                    Clay_TransitionProperty properties = transitionConfig->properties;
                     int32_t newActiveProperties = CLAY_TRANSITION_PROPERTY_NONE;
                     if (properties & CLAY_TRANSITION_PROPERTY_X) {
                         // Don't trigger a transition if...
@@ -4672,13 +7152,14 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                         transitionData->activeProperties = CLAY_TRANSITION_PROPERTY_NONE;
                     } else {
                         bool transitionComplete = true;
-                        transitionComplete = currentElement->config.transition.handler(CLAY__INIT(Clay_TransitionCallbackArguments) {
+                        // An exiting element's config may be the default one after a frame that ran out of configs, in which case it is removed
+                        if (transitionConfig->handler) transitionComplete = transitionConfig->handler(CLAY__INIT(Clay_TransitionCallbackArguments) {
                             transitionData->state,
                             transitionData->initialState,
                             &transitionData->currentState,
                             targetState,
                             transitionData->elapsedTime,
-                            currentElement->config.transition.duration,
+                            transitionConfig->duration,
                             transitionData->activeProperties
                         });
 
@@ -4691,14 +7172,15 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                                 transitionData->reparented = false;
                                 transitionData->activeProperties = CLAY_TRANSITION_PROPERTY_NONE;
                             } else if (transitionData->state == CLAY_TRANSITION_STATE_EXITING) {
-                                Clay__TransitionDataInternalArray_RemoveSwapback(&context->transitionDatas, i);
+                                Clay__RemoveTransitionData(i);
                             }
                         }
                     }
                 }
             }
 
-            if (context->debugModeEnabled) {
+            // The debug view would only lose its elements as well in a frame that has run out of them
+            if (context->debugModeEnabled && !context->booleanWarnings.maxElementsExceeded) {
                 context->warningsEnabled = false;
                 Clay__RenderDebugView();
                 context->warningsEnabled = true;
@@ -4717,7 +7199,8 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                 Clay__CloneElementsWithExitTransition();
             }
         } else {
-            if (context->debugModeEnabled) {
+            // The debug view would only lose its elements as well in a frame that has run out of them
+            if (context->debugModeEnabled && !context->booleanWarnings.maxElementsExceeded) {
                 context->warningsEnabled = false;
                 Clay__RenderDebugView();
                 context->warningsEnabled = true;
@@ -4731,50 +7214,98 @@ Clay_RenderCommandArray Clay_EndLayout(float deltaTime) {
                     .renderData = { .text = { .stringContents = CLAY__INIT(Clay_StringSlice) { .length = message.length, .chars = message.chars, .baseChars = message.chars }, .textColor = {255, 0, 0, 255}, .fontSize = 16 } },
                     .commandType = CLAY_RENDER_COMMAND_TYPE_TEXT
                 });
+            } else if (frameHash != 0 && frameHash == context->previousDeclarationHash) {
+                // Nothing has changed since last frame, and its render commands are still in the ephemeral arena
+                context->renderCommands.length = context->previousRenderCommandsLength;
+                context->renderCommands.unchanged = true;
+                // Pointer handling and scroll containers expect the same state that a full layout would have left behind
+                Clay__SortLayoutElementTreeRoots();
+                for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
+                    Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+                    if (scrollData->openThisFrame) {
+                        scrollData->layoutElement->dimensions = Clay__GetHashMapItem(scrollData->elementId)->layoutDimensions;
+                    }
+                }
             } else {
                 Clay__CalculateFinalLayout(deltaTime, false, true);
             }
         }
     }
-    if (context->openLayoutElementStack.length > 1) {
+    // Frames that weren't laid out still leave their measurements in the cache for the next frame
+    Clay__MeasurePendingText();
+    // Elements are left open when they're dropped for running out of capacity, which isn't an error when the arena can grow
+    if (context->openLayoutElementStack.length > 1 && !(context->booleanWarnings.maxElementsExceeded && Clay__ArenaCanGrow())) {
         context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                 .errorType = CLAY_ERROR_TYPE_UNBALANCED_OPEN_CLOSE,
                 .errorText = CLAY_STRING("There were still open layout elements when EndLayout was called. This results from an unequal number of calls to Clay__OpenElement and Clay__CloseElement."),
                 .userData = context->errorHandler.userData });
+        frameHash = 0;
+    }
+    // Rather than showing an error, a frame that ran out of elements is left empty, as the next one will have grown to fit it.
+    // Clay_DeclareLayout() declares it again straight away.
+    Clay__UpdateMemoryHighWaterMarks(context);
+    if (context->booleanWarnings.maxElementsExceeded && Clay__ArenaCanGrow()) {
+        context->renderCommands.length = 0;
+    }
+    // Only frames laid out without transitions or errors can be reused next frame
+    if (context->booleanWarnings.maxElementsExceeded || context->transitionDatas.length > 0) {
+        frameHash = 0;
+    }
+    context->previousDeclarationHash = frameHash;
+    context->previousRenderCommandsLength = context->renderCommands.length;
+    context->pointerHitGridDirty = true;
+    // The set of declared elements is the same as last frame, so there is nothing to prune
+    if (context->renderCommands.unchanged) {
+        return context->renderCommands;
     }
 
-    for (int i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
-        int32_t currentElementIndex = context->layoutElementsHashMap.internalArray[i];
-        int32_t previousElementIndex = -1;
-        int32_t listDepth = 0;
-        while (currentElementIndex != -1) {
-            Clay_LayoutElementHashMapItem* currentItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, currentElementIndex);
-            int32_t nextIndex = currentItem->nextIndex;
-            // Needs to be pruned
-            if (currentItem->generation <= context->generation) {
-                // If it's the very top of the bucket, rewrite the first bucket pointer
-                if (listDepth == 0) {
-                    Clay__int32_tArray_Set(&context->layoutElementsHashMap, i, nextIndex);
-                    listDepth--;
-                } else {
-                    // Rewrite previous pointer
-                    Clay_LayoutElementHashMapItem* previousItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, previousElementIndex);
-                    previousItem->nextIndex = nextIndex;
-                }
-                // Delete the underlying item and add it to the freelist
-                Clay__LayoutElementHashMapItemArray_Set(&context->layoutElementsHashMapInternal, currentElementIndex, CLAY__INIT(Clay_LayoutElementHashMapItem) { .nextIndex = -1 });
-                Clay__int32_tArray_Add(&context->layoutElementsHashMapFreeList, currentElementIndex);
-            }
-
-            previousElementIndex = currentElementIndex;
-            currentElementIndex = nextIndex;
-            listDepth++;
+    // Only the items that were live before this frame or added during it need to be checked, however large maxElementCount is
+    Clay__int32_tArray *liveList = &context->layoutElementsHashMapLiveList;
+    // When the arena is about to grow to fit the elements that were dropped from this frame, they're kept as if they had been declared
+    bool keepAllItems = context->booleanWarnings.maxElementsExceeded && Clay__ArenaCanGrow();
+    for (int32_t i = 0; i < liveList->length;) {
+        int32_t itemIndex = liveList->internalArray[i];
+        Clay_LayoutElementHashMapItem* currentItem = &context->layoutElementsHashMapInternal.internalArray[itemIndex];
+        if (keepAllItems) {
+            currentItem->generation = context->generation + 1;
+        }
+        // Needs to be pruned
+        if (currentItem->generation <= context->generation) {
+            Clay__RemoveHashMapSlot(currentItem->id);
+            // Delete the underlying item and add it to the freelist
+            *currentItem = CLAY__INIT(Clay_LayoutElementHashMapItem) CLAY__DEFAULT_STRUCT;
+            context->layoutElementsHashMapCold.internalArray[itemIndex] = CLAY__INIT(Clay__LayoutElementHashMapItemCold) CLAY__DEFAULT_STRUCT;
+            Clay__int32_tArray_Add(&context->layoutElementsHashMapFreeList, itemIndex);
+            liveList->internalArray[i] = liveList->internalArray[--liveList->length];
+        } else {
+            i++;
         }
     }
 
     return context->renderCommands;
 }
 
+Clay_RenderCommandArray Clay_DeclareLayout(void (*declareLayoutFunction)(void *userData), void *userData, float deltaTime) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_BeginLayout();
+    declareLayoutFunction(userData);
+    Clay_RenderCommandArray renderCommands = Clay_EndLayout(deltaTime);
+    // A frame that ran out of capacity didn't lay anything out or advance its transitions, so it can be declared again with the same
+    // deltaTime once Clay_BeginLayout() has grown the arena. Each attempt grows at least one of the capacities that ran out.
+    while (context->booleanWarnings.maxElementsExceeded && Clay__ArenaCanGrow()) {
+        void *previousBlock = context->arenaBlock;
+        Clay_BeginLayout();
+        // The block allocator returned NULL, so the frame is declared once more to close it and then left as it is
+        bool grew = context->arenaBlock != previousBlock;
+        declareLayoutFunction(userData);
+        renderCommands = Clay_EndLayout(deltaTime);
+        if (!grew) {
+            break;
+        }
+    }
+    return renderCommands;
+}
+
 CLAY_WASM_EXPORT("Clay_GetOpenElementId")
 uint32_t Clay_GetOpenElementId(void) {
     return Clay__GetOpenLayoutElement()->id;
@@ -4790,6 +7321,11 @@ Clay_ElementId Clay_GetElementIdWithIndex(Clay_String idString, uint32_t index)
     return Clay__HashStringWithOffset(idString, index, 0);
 }
 
+CLAY_WASM_EXPORT("Clay_HashStringContents")
+uint64_t Clay_HashStringContents(Clay_String text) {
+    return Clay__HashData((const uint8_t *)text.chars, text.length);
+}
+
 bool Clay_Hovered(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->booleanWarnings.maxElementsExceeded) {
@@ -4810,7 +7346,7 @@ void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_Pointer
         return;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(openLayoutElement->id);
+    Clay__LayoutElementHashMapItemCold *hashMapItem = Clay__GetHashMapItemCold(Clay__GetHashMapItem(openLayoutElement->id));
     hashMapItem->onHoverFunction = onHoverFunction;
     hashMapItem->hoverFunctionUserData = userData;
 }
@@ -4828,21 +7364,18 @@ bool Clay_PointerOver(Clay_ElementId elementId) { // TODO return priority for se
 
 CLAY_WASM_EXPORT("Clay_GetScrollContainerData")
 Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_ElementId id) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
-        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-        if (scrollContainerData->elementId == id.id) {
-            if (!scrollContainerData->layoutElement) { // This can happen on the first frame before a scroll container is declared
-                return CLAY__INIT(Clay_ScrollContainerData) CLAY__DEFAULT_STRUCT;
-            }
-            return CLAY__INIT(Clay_ScrollContainerData) {
-                .scrollPosition = &scrollContainerData->scrollPosition,
-                .scrollContainerDimensions = { scrollContainerData->boundingBox.width, scrollContainerData->boundingBox.height },
-                .contentDimensions = scrollContainerData->contentSize,
-                .config = scrollContainerData->layoutElement->config.clip,
-                .found = true
-            };
+    Clay__ScrollContainerDataInternal *scrollContainerData = Clay__FindScrollContainerData(id.id);
+    if (scrollContainerData) {
+        if (!scrollContainerData->layoutElement) { // This can happen on the first frame before a scroll container is declared
+            return CLAY__INIT(Clay_ScrollContainerData) CLAY__DEFAULT_STRUCT;
         }
+        return CLAY__INIT(Clay_ScrollContainerData) {
+            .scrollPosition = &scrollContainerData->scrollPosition,
+            .scrollContainerDimensions = { scrollContainerData->boundingBox.width, scrollContainerData->boundingBox.height },
+            .contentDimensions = scrollContainerData->contentSize,
+            .config = scrollContainerData->clipConfig,
+            .found = true
+        };
     }
     return CLAY__INIT(Clay_ScrollContainerData) CLAY__DEFAULT_STRUCT;
 }
@@ -4878,6 +7411,19 @@ void Clay_SetCullingEnabled(bool enabled) {
     context->disableCulling = !enabled;
 }
 
+CLAY_WASM_EXPORT("Clay_SetFrameReuseEnabled")
+void Clay_SetFrameReuseEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->frameReuseEnabled = enabled;
+    context->previousDeclarationHash = 0;
+}
+
+CLAY_WASM_EXPORT("Clay_SetIncrementalLayoutEnabled")
+void Clay_SetIncrementalLayoutEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->incrementalLayoutEnabled = enabled;
+}
+
 CLAY_WASM_EXPORT("Clay_SetExternalScrollHandlingEnabled")
 void Clay_SetExternalScrollHandlingEnabled(bool enabled) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -4895,6 +7441,7 @@ void Clay_SetMaxElementCount(int32_t maxElementCount) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context) {
         context->maxElementCount = maxElementCount;
+        context->arenaGrowthRequested = true;
     } else {
         Clay__defaultMaxElementCount = maxElementCount; // TODO: Fix this
         Clay__defaultMaxMeasureTextWordCacheCount = maxElementCount * 2;
@@ -4912,11 +7459,197 @@ void Clay_SetMaxMeasureTextCacheWordCount(int32_t maxMeasureTextCacheWordCount)
     Clay_Context* context = Clay_GetCurrentContext();
     if (context) {
         Clay__currentContext->maxMeasureTextCacheWordCount = maxMeasureTextCacheWordCount;
+        context->arenaGrowthRequested = true;
     } else {
         Clay__defaultMaxMeasureTextWordCacheCount = maxMeasureTextCacheWordCount; // TODO: Fix this
     }
 }
 
+CLAY_WASM_EXPORT("Clay_GetMaxElementConfigCount")
+int32_t Clay_GetMaxElementConfigCount(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->maxElementConfigCount > 0 ? context->maxElementConfigCount : CLAY__MAX(context->maxElementCount / 4, 1);
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxElementConfigCount")
+void Clay_SetMaxElementConfigCount(int32_t maxElementConfigCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxElementConfigCount = maxElementConfigCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxElementConfigCount = maxElementConfigCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxScrollContainerCount")
+int32_t Clay_GetMaxScrollContainerCount(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->maxScrollContainerCount > 0 ? context->maxScrollContainerCount : CLAY__MAX(context->maxElementCount / 32, 100);
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxScrollContainerCount")
+void Clay_SetMaxScrollContainerCount(int32_t maxScrollContainerCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxScrollContainerCount = maxScrollContainerCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxScrollContainerCount = maxScrollContainerCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxRenderCommandCount")
+void Clay_SetMaxRenderCommandCount(int32_t maxRenderCommandCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxRenderCommandCount = maxRenderCommandCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxRenderCommandCount = maxRenderCommandCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxWrappedTextLineCount")
+void Clay_SetMaxWrappedTextLineCount(int32_t maxWrappedTextLineCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxWrappedTextLineCount = maxWrappedTextLineCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxWrappedTextLineCount = maxWrappedTextLineCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxPointerOverIdCount")
+void Clay_SetMaxPointerOverIdCount(int32_t maxPointerOverIdCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxPointerOverIdCount = maxPointerOverIdCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxPointerOverIdCount = maxPointerOverIdCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxDynamicStringDataSize")
+void Clay_SetMaxDynamicStringDataSize(int32_t maxDynamicStringDataSize) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxDynamicStringDataSize = maxDynamicStringDataSize;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxDynamicStringDataSize = maxDynamicStringDataSize;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxTransitionCount")
+void Clay_SetMaxTransitionCount(int32_t maxTransitionCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxTransitionCount = maxTransitionCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxTransitionCount = maxTransitionCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxTextMeasurementBatchSize")
+void Clay_SetMaxTextMeasurementBatchSize(int32_t maxTextMeasurementBatchSize) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxTextMeasurementBatchSize = maxTextMeasurementBatchSize;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxTextMeasurementBatchSize = maxTextMeasurementBatchSize;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxPointerHitGridElementCount")
+void Clay_SetMaxPointerHitGridElementCount(int32_t maxPointerHitGridElementCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->maxPointerHitGridElementCount = maxPointerHitGridElementCount;
+        context->arenaGrowthRequested = true;
+    } else {
+        Clay__defaultMaxPointerHitGridElementCount = maxPointerHitGridElementCount;
+    }
+}
+
+#define CLAY__ARRAY_BYTES(array) ((size_t)(array).capacity * sizeof(*(array).internalArray))
+
+CLAY_WASM_EXPORT("Clay_GetMemoryUsage")
+Clay_MemoryUsage Clay_GetMemoryUsage(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_MemoryUsage usage = context->memoryUsage;
+    usage.arenaBytesUsed = context->internalArena.nextAllocation;
+    usage.arenaCapacity = context->internalArena.capacity;
+
+    usage.elements.capacity = context->layoutElements.capacity;
+    usage.elements.bytes = CLAY__ARRAY_BYTES(context->layoutElements) + CLAY__ARRAY_BYTES(context->layoutElementData) + CLAY__ARRAY_BYTES(context->layoutElementIdStrings)
+        + CLAY__ARRAY_BYTES(context->layoutElementChildren) + CLAY__ARRAY_BYTES(context->layoutElementChildrenBuffer) + CLAY__ARRAY_BYTES(context->layoutElementTreeNodeArray1)
+        + CLAY__ARRAY_BYTES(context->openLayoutElementStack) + CLAY__ARRAY_BYTES(context->treeNodeVisited) + CLAY__ARRAY_BYTES(context->openClipElementStack)
+        + CLAY__ARRAY_BYTES(context->reusableElementIndexBuffer) + CLAY__ARRAY_BYTES(context->layoutElementClipElementIds);
+
+    usage.elementIds.capacity = context->layoutElementsHashMapInternal.capacity;
+    usage.elementIds.bytes = CLAY__ARRAY_BYTES(context->layoutElementsHashMapInternal) + CLAY__ARRAY_BYTES(context->layoutElementsHashMapCold)
+        + CLAY__ARRAY_BYTES(context->layoutElementsHashMap) + CLAY__ARRAY_BYTES(context->layoutElementsHashMapFreeList) + CLAY__ARRAY_BYTES(context->layoutElementsHashMapLiveList);
+
+    usage.elementConfigs.capacity = context->floatingConfigs.capacity - 1;
+    usage.elementConfigs.bytes = CLAY__ARRAY_BYTES(context->floatingConfigs) + CLAY__ARRAY_BYTES(context->clipConfigs) + CLAY__ARRAY_BYTES(context->borderConfigs)
+        + CLAY__ARRAY_BYTES(context->transitionConfigs) + CLAY__ARRAY_BYTES(context->imageConfigs) + CLAY__ARRAY_BYTES(context->customConfigs)
+        + CLAY__ARRAY_BYTES(context->layoutElementTreeRoots) + CLAY__ARRAY_BYTES(context->layoutElementTreeRootsSortBuffer);
+
+    usage.renderCommands.capacity = context->renderCommands.capacity;
+    usage.renderCommands.bytes = CLAY__ARRAY_BYTES(context->renderCommands);
+    usage.wrappedTextLines.capacity = context->wrappedTextLines.capacity;
+    usage.wrappedTextLines.bytes = CLAY__ARRAY_BYTES(context->wrappedTextLines);
+    usage.pointerOverIds.capacity = context->pointerOverIds.capacity;
+    usage.pointerOverIds.bytes = CLAY__ARRAY_BYTES(context->pointerOverIds);
+    usage.dynamicStringData.capacity = context->dynamicStringData.capacity;
+    usage.dynamicStringData.bytes = CLAY__ARRAY_BYTES(context->dynamicStringData);
+    usage.scrollContainers.capacity = context->scrollContainerDatas.capacity;
+    usage.scrollContainers.bytes = CLAY__ARRAY_BYTES(context->scrollContainerDatas);
+    usage.transitions.capacity = context->transitionDatas.capacity;
+    usage.transitions.bytes = CLAY__ARRAY_BYTES(context->transitionDatas);
+    usage.pointerHitGrid.capacity = context->pointerHitRecords.capacity;
+    usage.pointerHitGrid.bytes = CLAY__ARRAY_BYTES(context->pointerHitRecords) + CLAY__ARRAY_BYTES(context->pointerHitGridCellStarts) + CLAY__ARRAY_BYTES(context->pointerHitGridEntries);
+    usage.textMeasurementBatch.capacity = context->pendingTextMeasurements.capacity;
+    usage.textMeasurementBatch.bytes = CLAY__ARRAY_BYTES(context->pendingTextMeasurements) + CLAY__ARRAY_BYTES(context->textMeasurementRequests)
+        + CLAY__ARRAY_BYTES(context->textMeasurementTargets) + CLAY__ARRAY_BYTES(context->textMeasurementResults);
+
+    usage.measureTextCacheItems.capacity = context->measureTextHashMapInternal.capacity - 1;
+    usage.measureTextCacheItems.bytes = CLAY__ARRAY_BYTES(context->measureTextHashMapInternal) + CLAY__ARRAY_BYTES(context->measureTextHashMapInternalFreeList)
+        + CLAY__ARRAY_BYTES(context->measureTextHashMap);
+    usage.measuredWords.capacity = context->measuredWords.capacity;
+    usage.measuredWords.bytes = CLAY__ARRAY_BYTES(context->measuredWords) + CLAY__ARRAY_BYTES(context->measuredWordRunOwners);
+    usage.warnings.capacity = context->warnings.capacity;
+    usage.warnings.bytes = CLAY__ARRAY_BYTES(context->warnings);
+    return usage;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMeasureTextCacheMemoryBudget")
+void Clay_SetMeasureTextCacheMemoryBudget(uint32_t budgetBytes) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->measureTextCacheMemoryBudget = budgetBytes;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMeasureTextCacheRetentionGenerations")
+void Clay_SetMeasureTextCacheRetentionGenerations(uint32_t generations) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->measureTextCacheRetentionGenerations = generations;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMeasureTextCacheStats")
+Clay_MeasureTextCacheStats Clay_GetMeasureTextCacheStats(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_MeasureTextCacheStats stats = context->measureTextCacheStats;
+    stats.itemsResident = context->measureTextHashMapInternal.length - 1 - context->measureTextHashMapInternalFreeList.length;
+    stats.wordsResident = context->measuredWords.length - context->measuredWordsFreeCount;
+    stats.bytesResident = (uint32_t)stats.wordsResident * (uint32_t)sizeof(Clay__MeasuredWord);
+    return stats;
+}
+
 CLAY_WASM_EXPORT("Clay_ResetMeasureTextCache")
 void Clay_ResetMeasureTextCache(void) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -4924,12 +7657,134 @@ void Clay_ResetMeasureTextCache(void) {
     context->measureTextHashMapInternalFreeList.length = 0;
     context->measureTextHashMap.length = 0;
     context->measuredWords.length = 0;
-    context->measuredWordsFreeList.length = 0;
+    context->measuredWordsFreeCount = 0;
+    context->measureTextCacheClockHand = 0;
 
     for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
         context->measureTextHashMap.internalArray[i] = 0;
     }
     context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
+    context->pendingTextMeasurements.length = 0;
+    // Text may measure differently after a reset, so invalidate layout results retained by incremental layout
+    context->layoutFingerprintSeed++;
+}
+
+// Items that are still waiting for Clay_SetMeasureTextBatchFunction() have no measurements yet, and statically allocated text
+// is skipped if an item for the same contents is exported anyway
+bool Clay__ShouldExportMeasureTextCacheItem(Clay__MeasureTextCacheItem *item) {
+    if (item->id == 0 || item->measurementPending) {
+        return false;
+    }
+    return !item->keyedByAddress || !Clay__FindMeasureTextCacheItem(item->contentId, item->textLength, item->contentsHash);
+}
+
+CLAY_WASM_EXPORT("Clay_ExportMeasureTextCache")
+uint32_t Clay_ExportMeasureTextCache(uint32_t capacity, void *memory, uint32_t fontSetVersion) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheExportHeader header = { CLAY__MEASURE_TEXT_CACHE_EXPORT_MAGIC, CLAY__MEASURE_TEXT_CACHE_EXPORT_VERSION, fontSetVersion, 0, 0 };
+    for (int32_t i = 1; i < context->measureTextHashMapInternal.length; ++i) {
+        Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, i);
+        if (!Clay__ShouldExportMeasureTextCacheItem(item)) {
+            continue;
+        }
+        header.itemCount++;
+        header.wordCount += item->measuredWordsCount;
+    }
+    uint64_t size = sizeof(Clay__MeasureTextCacheExportHeader) + (uint64_t)header.itemCount * sizeof(Clay__MeasureTextCacheExportItem) + (uint64_t)header.wordCount * sizeof(Clay__MeasureTextCacheExportWord);
+    // The size is returned as a uint32_t, so a cache that doesn't fit in one can't be exported
+    if (size > UINT32_MAX) {
+        return 0;
+    }
+    if (capacity < size || !memory) {
+        return (uint32_t)size;
+    }
+
+    *(Clay__MeasureTextCacheExportHeader *)memory = header;
+    Clay__MeasureTextCacheExportItem *exportItem = (Clay__MeasureTextCacheExportItem *)((char *)memory + sizeof(Clay__MeasureTextCacheExportHeader));
+    Clay__MeasureTextCacheExportWord *exportWord = (Clay__MeasureTextCacheExportWord *)(exportItem + header.itemCount);
+    for (int32_t i = 1; i < context->measureTextHashMapInternal.length; ++i) {
+        Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, i);
+        if (!Clay__ShouldExportMeasureTextCacheItem(item)) {
+            continue;
+        }
+        *exportItem = CLAY__INIT(Clay__MeasureTextCacheExportItem) {
+            item->contentId, (uint32_t)item->textLength, (uint32_t)item->contentsHash, (uint32_t)(item->contentsHash >> 32), (uint32_t)item->measuredWordsCount,
+            item->unwrappedDimensions, item->minWidth, item->spaceWidth, item->containsNewlines
+        };
+        for (int32_t j = 0; j < item->measuredWordsCount; ++j) {
+            Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, item->measuredWordsStartIndex + j);
+            *exportWord = CLAY__INIT(Clay__MeasureTextCacheExportWord) { measuredWord->startOffset, measuredWord->length, measuredWord->width };
+            exportWord++;
+        }
+        exportItem++;
+    }
+    return (uint32_t)size;
+}
+
+CLAY_WASM_EXPORT("Clay_ImportMeasureTextCache")
+bool Clay_ImportMeasureTextCache(uint32_t size, const void *memory, uint32_t fontSetVersion) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!memory || (uintptr_t)memory % 4 != 0 || size < sizeof(Clay__MeasureTextCacheExportHeader)) {
+        return false;
+    }
+    Clay__MeasureTextCacheExportHeader header = *(const Clay__MeasureTextCacheExportHeader *)memory;
+    if (header.magic != CLAY__MEASURE_TEXT_CACHE_EXPORT_MAGIC || header.formatVersion != CLAY__MEASURE_TEXT_CACHE_EXPORT_VERSION || header.fontSetVersion != fontSetVersion) {
+        return false;
+    }
+    uint64_t expectedSize = sizeof(Clay__MeasureTextCacheExportHeader) + (uint64_t)header.itemCount * sizeof(Clay__MeasureTextCacheExportItem) + (uint64_t)header.wordCount * sizeof(Clay__MeasureTextCacheExportWord);
+    if (expectedSize != size) {
+        return false;
+    }
+
+    const Clay__MeasureTextCacheExportItem *exportItems = (const Clay__MeasureTextCacheExportItem *)((const char *)memory + sizeof(Clay__MeasureTextCacheExportHeader));
+    const Clay__MeasureTextCacheExportWord *exportWord = (const Clay__MeasureTextCacheExportWord *)(exportItems + header.itemCount);
+    const Clay__MeasureTextCacheExportWord *exportWordsEnd = exportWord + header.wordCount;
+    for (uint32_t i = 0; i < header.itemCount; ++i) {
+        const Clay__MeasureTextCacheExportItem *exportItem = &exportItems[i];
+        if (exportItem->wordCount > (uint32_t)(exportWordsEnd - exportWord)) {
+            return false;
+        }
+        const Clay__MeasureTextCacheExportWord *itemWords = exportWord;
+        exportWord += exportItem->wordCount;
+        if (exportItem->textLength > INT32_MAX) {
+            return false;
+        }
+        // Words are stored in order and must lie within the text, as they're only ever used as offsets into text with the same
+        // length and contents hash
+        int32_t textLength = (int32_t)exportItem->textLength;
+        int32_t previousEnd = 0;
+        for (uint32_t j = 0; j < exportItem->wordCount; ++j) {
+            if (itemWords[j].length < 0 || itemWords[j].startOffset < previousEnd || itemWords[j].startOffset > textLength - itemWords[j].length) {
+                return false;
+            }
+            previousEnd = itemWords[j].startOffset + itemWords[j].length;
+        }
+        uint64_t contentsHash = (uint64_t)exportItem->contentsHashLow | ((uint64_t)exportItem->contentsHashHigh << 32);
+        // Imported items are evicted like any other if they aren't used, so a full cache just skips the rest
+        if (exportItem->contentId == 0 || Clay__FindMeasureTextCacheItem(exportItem->contentId, textLength, contentsHash) || !Clay__ReserveMeasuredWords((int32_t)exportItem->wordCount, true)) {
+            continue;
+        }
+        int32_t itemIndex = Clay__AddMeasureTextCacheItem(CLAY__INIT(Clay__MeasureTextCacheItem) {
+            .unwrappedDimensions = exportItem->unwrappedDimensions,
+            .measuredWordsStartIndex = -1,
+            .minWidth = exportItem->minWidth,
+            .spaceWidth = exportItem->spaceWidth,
+            .containsNewlines = exportItem->containsNewlines != 0,
+            .textLength = textLength,
+            .contentsHash = contentsHash,
+            .id = exportItem->contentId,
+            .contentId = exportItem->contentId,
+            .generation = context->generation,
+        });
+        if (itemIndex == 0) {
+            break;
+        }
+        for (uint32_t j = 0; j < exportItem->wordCount; ++j) {
+            Clay__AddMeasuredWord(itemIndex, CLAY__INIT(Clay__MeasuredWord) { .startOffset = itemWords[j].startOffset, .length = itemWords[j].length, .width = itemWords[j].width });
+        }
+        Clay__LinkMeasureTextCacheItem(itemIndex, exportItem->contentId % (context->maxMeasureTextCacheWordCount / 32));
+    }
+    return true;
 }
 
 #define CLAY__LERP(from, to, mix) (from + (to - from) * mix)